@@ -0,0 +1,346 @@
+/********************************************************************************
+ *  File Name:
+ *    ulog_bench.cpp
+ *
+ *  Description:
+ *    Measures the cost of the uLog hot paths on a Linux host and reports the
+ *    per call latency distribution of each case as JSON.
+ *
+ *    Usage: ulog_bench [--iterations N] [--max-threads N] [--output FILE]
+ *
+ *    The contention case runs powers of two up to --max-threads (the core count
+ *    by default), and --max-threads itself.
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* C++ Includes */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*-------------------------------------------------
+With ULOG_STATIC_SINK_STORAGE, makeSink() needs room for
+a full registry of null sinks plus the direct one
+-------------------------------------------------*/
+#ifndef ULOG_STATIC_SINKS_PER_TYPE
+#define ULOG_STATIC_SINKS_PER_TYPE ( ULOG_MAX_REGISTERABLE_SINKS + 1u )
+#endif
+
+/* uLog Includes */
+#include <uLog/ulog.hpp>
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   *  Accepts everything and does nothing, so only uLog's own overhead is timed
+   */
+  class NullSink : public uLog::SinkInterface
+  {
+  public:
+    uLog::Result open() final override
+    {
+      return uLog::Result::RESULT_SUCCESS;
+    }
+
+    uLog::Result close() final override
+    {
+      return uLog::Result::RESULT_SUCCESS;
+    }
+
+    uLog::Result flush() final override
+    {
+      return uLog::Result::RESULT_SUCCESS;
+    }
+
+    uLog::IOType getIOType() final override
+    {
+      return uLog::IOType::CONSOLE_SINK;
+    }
+
+    uLog::Result log( const uLog::Level level, const void *const message, const size_t length ) final override
+    {
+      if ( !isEnabled() || ( level < getLogLevel() ) || !message || !length )
+      {
+        return uLog::Result::RESULT_FAIL;
+      }
+
+      mBytes.fetch_add( length, std::memory_order_relaxed );
+      return uLog::Result::RESULT_SUCCESS;
+    }
+
+  private:
+    std::atomic<size_t> mBytes{ 0 };
+  };
+
+  struct BenchResult
+  {
+    std::string name;
+    size_t threads;
+    size_t sinks;
+    size_t samples;
+    double mean;
+    double p50;
+    double p99;
+    double p999;
+  };
+
+  struct Options
+  {
+    size_t iterations = 200000;
+    size_t maxThreads = std::max( 1u, std::thread::hardware_concurrency() );
+    std::string output;
+  };
+
+  static constexpr char RawMessage[] = "sensor 3 read 1234 mV on channel 7\n";
+
+  double percentile( const std::vector<uint32_t> &sorted, const double pct )
+  {
+    const size_t index = std::min( sorted.size() - 1, static_cast<size_t>( pct * ( sorted.size() - 1 ) ) );
+    return sorted[ index ];
+  }
+
+  /**
+   *  Resets the registry to hold 'count' fresh null sinks at the given level
+   */
+  void installSinks( const size_t count, const uLog::Level level )
+  {
+    static std::vector<uLog::SinkHandle> installed;
+
+    uLog::SinkHandle all = nullptr;
+    uLog::removeSink( all );
+
+    for ( uLog::SinkHandle &sink : installed )
+    {
+      uLog::releaseSink<NullSink>( sink );
+    }
+
+    installed.clear();
+
+    for ( size_t i = 0; i < count; i++ )
+    {
+      uLog::SinkHandle sink = uLog::makeSink<NullSink>();
+      sink->setLogLevel( level );
+      sink->enable();
+      uLog::registerSink( sink );
+      installed.push_back( sink );
+    }
+  }
+
+  /**
+   *  Times 'op' individually on each of 'threads' threads started together
+   */
+  BenchResult run( const std::string &name, const size_t threads, const size_t sinks, const Options &opts,
+                   const std::function<void()> &op )
+  {
+    std::vector<std::vector<uint32_t>> samples( threads );
+    std::atomic<size_t> ready{ 0 };
+    std::atomic<bool> go{ false };
+    std::vector<std::thread> workers;
+
+    for ( size_t t = 0; t < threads; t++ )
+    {
+      workers.emplace_back( [ &, t ] {
+        auto &mine = samples[ t ];
+        mine.reserve( opts.iterations );
+
+        ready.fetch_add( 1 );
+        while ( !go.load( std::memory_order_acquire ) )
+        {
+        }
+
+        for ( size_t i = 0; i < opts.iterations; i++ )
+        {
+          const auto start = Clock::now();
+          op();
+          const auto stop = Clock::now();
+          mine.push_back( static_cast<uint32_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( stop - start ).count() ) );
+        }
+      } );
+    }
+
+    while ( ready.load() != threads )
+    {
+    }
+
+    go.store( true, std::memory_order_release );
+
+    for ( auto &worker : workers )
+    {
+      worker.join();
+    }
+
+    /*------------------------------------------------
+    Merge and summarize
+    ------------------------------------------------*/
+    std::vector<uint32_t> merged;
+    merged.reserve( threads * opts.iterations );
+    for ( auto &s : samples )
+    {
+      merged.insert( merged.end(), s.begin(), s.end() );
+    }
+
+    std::sort( merged.begin(), merged.end() );
+
+    double total = 0.0;
+    for ( auto v : merged )
+    {
+      total += v;
+    }
+
+    BenchResult result;
+    result.name    = name;
+    result.threads = threads;
+    result.sinks   = sinks;
+    result.samples = merged.size();
+    result.mean    = total / merged.size();
+    result.p50     = percentile( merged, 0.50 );
+    result.p99     = percentile( merged, 0.99 );
+    result.p999    = percentile( merged, 0.999 );
+
+    fprintf( stderr, "%-28s threads=%-3zu sinks=%-3zu p50=%8.0f p99=%8.0f p99.9=%8.0f ns\n", name.c_str(), threads, sinks,
+             result.p50, result.p99, result.p999 );
+    return result;
+  }
+
+  void writeJson( FILE *out, const std::vector<BenchResult> &results )
+  {
+    fprintf( out, "{\n  \"benchmarks\": [\n" );
+
+    for ( size_t i = 0; i < results.size(); i++ )
+    {
+      const auto &r = results[ i ];
+      fprintf( out,
+               "    {\"name\": \"%s\", \"threads\": %zu, \"sinks\": %zu, \"samples\": %zu, "
+               "\"ns_mean\": %.1f, \"ns_p50\": %.0f, \"ns_p99\": %.0f, \"ns_p999\": %.0f}%s\n",
+               r.name.c_str(), r.threads, r.sinks, r.samples, r.mean, r.p50, r.p99, r.p999,
+               ( i + 1 < results.size() ) ? "," : "" );
+    }
+
+    fprintf( out, "  ]\n}\n" );
+  }
+
+  Options parseArgs( int argc, char **argv )
+  {
+    Options opts;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+      const bool hasValue = ( i + 1 ) < argc;
+
+      if ( !strcmp( argv[ i ], "--iterations" ) && hasValue )
+      {
+        opts.iterations = std::max<size_t>( 1, strtoul( argv[ ++i ], nullptr, 0 ) );
+      }
+      else if ( !strcmp( argv[ i ], "--max-threads" ) && hasValue )
+      {
+        opts.maxThreads = std::max<size_t>( 1, strtoul( argv[ ++i ], nullptr, 0 ) );
+      }
+      else if ( !strcmp( argv[ i ], "--output" ) && hasValue )
+      {
+        opts.output = argv[ ++i ];
+      }
+      else
+      {
+        fprintf( stderr, "Usage: %s [--iterations N] [--max-threads N] [--output FILE]\n", argv[ 0 ] );
+        exit( EXIT_FAILURE );
+      }
+    }
+
+    return opts;
+  }
+}    // namespace
+
+int main( int argc, char **argv )
+{
+  using namespace uLog;
+
+  const Options opts = parseArgs( argc, argv );
+  std::vector<BenchResult> results;
+
+  initialize();
+  setGlobalLogLevel( Level::LVL_INFO );
+
+  auto logRaw = [] { log( Level::LVL_INFO, RawMessage, sizeof( RawMessage ) - 1 ); };
+
+  /*------------------------------------------------
+  Single sink cases
+  ------------------------------------------------*/
+  installSinks( 1, Level::LVL_INFO );
+
+  results.push_back( run( "log_filtered_level", 1, 1, opts, [] { log( Level::LVL_TRACE, RawMessage, sizeof( RawMessage ) - 1 ); } ) );
+  results.push_back( run( "flog_filtered_level", 1, 1, opts, [] { flog( Level::LVL_TRACE, "sensor %d read %u mV", 3, 1234u ); } ) );
+  results.push_back( run( "log_raw_null_sink", 1, 1, opts, logRaw ) );
+  results.push_back( run( "flog_formatted_null_sink", 1, 1, opts, [] { flog( Level::LVL_INFO, "sensor %d read %u mV on channel %s\n", 3, 1234u, "seven" ); } ) );
+  results.push_back( run( "flog_compiled_null_sink", 1, 1, opts, [] { flog( Level::LVL_INFO, ULOG_FMT( "sensor %d read %u mV on channel %s\n" ), 3, 1234u, "seven" ); } ) );
+  results.push_back( run( "flog_compiled_float_null_sink", 1, 1, opts, [] { flog( Level::LVL_INFO, ULOG_FMT( "t=%.3f v=%x\n" ), 12.345, 0xBEEFu ); } ) );
+  results.push_back( run( "flog_float_null_sink", 1, 1, opts, [] { flog( Level::LVL_INFO, "t=%.3f v=%x\n", 12.345, 0xBEEFu ); } ) );
+
+  SinkHandle direct = makeSink<NullSink>();
+  direct->setLogLevel( Level::LVL_INFO );
+  direct->enable();
+  direct->setName( "bench" );
+  results.push_back( run( "sink_flog_formatted", 1, 1, opts, [ &direct ] { direct->flog( Level::LVL_INFO, "sensor %d read %u mV on channel %s\n", 3, 1234u, "seven" ); } ) );
+  results.push_back( run( "sink_flog_compiled", 1, 1, opts, [ &direct ] { direct->flog( Level::LVL_INFO, ULOG_FMT( "sensor %d read %u mV on channel %s\n" ), 3, 1234u, "seven" ); } ) );
+
+  /*------------------------------------------------
+  Fan out across an increasing number of sinks
+  ------------------------------------------------*/
+  for ( size_t sinks = 1; sinks <= ULOG_MAX_REGISTERABLE_SINKS; sinks++ )
+  {
+    installSinks( sinks, Level::LVL_INFO );
+    results.push_back( run( "log_raw_fanout", 1, sinks, opts, logRaw ) );
+  }
+
+  /*------------------------------------------------
+  Contention between producer threads
+  ------------------------------------------------*/
+  installSinks( 1, Level::LVL_INFO );
+
+  /*------------------------------------------------
+  Powers of two, then the core count itself in case
+  it isn't one
+  ------------------------------------------------*/
+  for ( size_t threads = 1; threads < opts.maxThreads; threads *= 2 )
+  {
+    results.push_back( run( "log_raw_contended", threads, 1, opts, logRaw ) );
+  }
+
+  results.push_back( run( "log_raw_contended", opts.maxThreads, 1, opts, logRaw ) );
+
+  SinkHandle all = nullptr;
+  removeSink( all );
+
+  /*------------------------------------------------
+  Report
+  ------------------------------------------------*/
+  FILE *out = stdout;
+  if ( !opts.output.empty() )
+  {
+    out = fopen( opts.output.c_str(), "w" );
+    if ( !out )
+    {
+      perror( opts.output.c_str() );
+      return EXIT_FAILURE;
+    }
+  }
+
+  writeJson( out, results );
+
+  if ( out != stdout )
+  {
+    fclose( out );
+  }
+
+  return EXIT_SUCCESS;
+}
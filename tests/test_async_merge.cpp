@@ -0,0 +1,267 @@
+/********************************************************************************
+ *  File Name:
+ *    test_async_merge.cpp
+ *
+ *  Description:
+ *    Checks the merge of the per thread asynchronous queues. Several producers
+ *    log through both uLog::log() and Reservations while the drain runs, and
+ *    the records reaching the sink must be in time order, numbered without
+ *    gaps, in each producer's own order, and together with the drops account
+ *    for every message sent. A FATAL message logged while holding a Reservation
+ *    must not wait on its own unpublished queue cell. Last, panicFlush() must
+ *    deliver what is left in the queues once the drain has stopped.
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* C++ Includes */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/* uLog Includes */
+#include <uLog/record.hpp>
+#include <uLog/ulog.hpp>
+
+#if ( ULOG_ENABLE_ASYNC_MODE != 1 ) || ( ULOG_ASYNC_PER_THREAD_QUEUES != 1 )
+#error "test_async_merge needs ULOG_ENABLE_ASYNC_MODE and ULOG_ASYNC_PER_THREAD_QUEUES"
+#endif
+
+/*-------------------------------------------------------------------------------
+Constants
+-------------------------------------------------------------------------------*/
+static constexpr int Producers = 4;
+static constexpr int Messages  = 5000;
+
+/*-------------------------------------------------------------------------------
+Classes
+-------------------------------------------------------------------------------*/
+/**
+ *  Keeps the header fields and payload of every binary record it is given
+ */
+class CaptureSink : public uLog::SinkInterface
+{
+public:
+  struct Entry
+  {
+    uint32_t sequence;
+    uint64_t tick;
+    int producer;
+    int index;
+  };
+
+  std::vector<Entry> entries;
+  size_t panicked = 0;
+
+  uLog::Result open() override
+  {
+    return uLog::Result::RESULT_SUCCESS;
+  }
+
+  uLog::Result close() override
+  {
+    return uLog::Result::RESULT_SUCCESS;
+  }
+
+  uLog::Result flush() override
+  {
+    return uLog::Result::RESULT_SUCCESS;
+  }
+
+  uLog::IOType getIOType() override
+  {
+    return uLog::IOType::CONSOLE_SINK;
+  }
+
+  uLog::Result log( const uLog::Level level, const void *const message, const size_t length ) override
+  {
+    ( void )level;
+    const uint8_t *const record = static_cast<const uint8_t *>( message );
+
+    Entry entry        = { 0, 0, -1, -1 };
+    char payload[ 32 ] = {};
+
+    if ( length >= uLog::RecordHeaderSize )
+    {
+      memcpy( &entry.sequence, record + 6, sizeof( entry.sequence ) );
+      memcpy( &entry.tick, record + 10, sizeof( entry.tick ) );
+      memcpy( payload, record + uLog::RecordHeaderSize, std::min( length - uLog::RecordHeaderSize, sizeof( payload ) - 1 ) );
+      sscanf( payload, "%d %d", &entry.producer, &entry.index );
+    }
+
+    entries.push_back( entry );
+    return uLog::Result::RESULT_SUCCESS;
+  }
+
+  bool panicLog( const uLog::Level level, const uLog::Tick tick, const void *const message, const size_t length ) override
+  {
+    ( void )level;
+    ( void )tick;
+    ( void )message;
+    ( void )length;
+    panicked++;
+    return true;
+  }
+};
+
+/*-------------------------------------------------------------------------------
+Static Functions
+-------------------------------------------------------------------------------*/
+/**
+ *  Logs this producer's messages, every seventh through a Reservation
+ *
+ *  @param[in]  producer  Producer number
+ */
+static void produce( const int producer )
+{
+  char text[ 32 ];
+
+  for ( int i = 0; i < Messages; i++ )
+  {
+    if ( ( i % 7 ) == 0 )
+    {
+      uLog::Reservation reservation( uLog::Level::LVL_INFO, sizeof( text ) );
+      if ( reservation.valid() )
+      {
+        const int length = snprintf( static_cast<char *>( reservation.data() ), sizeof( text ), "%d %d", producer, i );
+        reservation.commit( length );
+      }
+    }
+    else
+    {
+      const int length = snprintf( text, sizeof( text ), "%d %d", producer, i );
+      uLog::log( uLog::Level::LVL_INFO, text, length );
+    }
+
+    /*----------------------------------------------
+    Give the drain a chance on machines with few cores
+    ----------------------------------------------*/
+    if ( ( i % 16 ) == 0 )
+    {
+      std::this_thread::sleep_for( std::chrono::microseconds( 50 ) );
+    }
+  }
+}
+
+int main()
+{
+  /*------------------------------------------------
+  A watchdog, as one of the failures tested is a hang
+  ------------------------------------------------*/
+  std::thread( [] {
+    std::this_thread::sleep_for( std::chrono::seconds( 60 ) );
+    printf( "FAIL timed out\n" );
+    fflush( stdout );
+    std::_Exit( 1 );
+  } ).detach();
+
+  uLog::initialize();
+  uLog::setGlobalLogLevel( uLog::Level::LVL_INFO );
+
+  auto capture          = std::make_shared<CaptureSink>();
+  uLog::SinkHandle sink = capture;
+  sink->setName( "capture" );
+  sink->setRecordFormat( uLog::RecordFormat::BINARY );
+  sink->setLogLevel( uLog::Level::LVL_INFO );
+  sink->enable();
+  uLog::registerSink( sink );
+
+  std::thread drain( [] { uLog::asyncDrainThread( nullptr ); } );
+
+  std::vector<std::thread> producers;
+  for ( int p = 0; p < Producers; p++ )
+  {
+    producers.emplace_back( produce, p );
+  }
+
+  for ( std::thread &producer : producers )
+  {
+    producer.join();
+  }
+
+  /*------------------------------------------------
+  The drain can't get past the held cell, so the FATAL
+  flush has to be skipped rather than wait on it
+  ------------------------------------------------*/
+  {
+    uLog::Reservation held( uLog::Level::LVL_INFO, 16 );
+    uLog::log( uLog::Level::LVL_FATAL, "fatal", 5 );
+  }
+
+  uLog::flush();
+  uLog::stopAsyncDrain();
+  drain.join();
+
+  /*------------------------------------------------
+  Check the order the sink saw
+  ------------------------------------------------*/
+  size_t failures  = 0;
+  size_t delivered = 0;
+  std::vector<int> last( Producers, -1 );
+  const std::vector<CaptureSink::Entry> &entries = capture->entries;
+
+  for ( size_t i = 0; i < entries.size(); i++ )
+  {
+    const CaptureSink::Entry &entry = entries[ i ];
+
+    if ( i && ( entry.tick < entries[ i - 1 ].tick ) )
+    {
+      printf( "FAIL record %zu: tick %llu before %llu\n", i, static_cast<unsigned long long>( entry.tick ),
+              static_cast<unsigned long long>( entries[ i - 1 ].tick ) );
+      failures++;
+    }
+
+    if ( i && ( entry.sequence != ( entries[ i - 1 ].sequence + 1 ) ) )
+    {
+      printf( "FAIL record %zu: sequence %u after %u\n", i, entry.sequence, entries[ i - 1 ].sequence );
+      failures++;
+    }
+
+    if ( ( entry.producer >= 0 ) && ( entry.producer < Producers ) )
+    {
+      if ( entry.index <= last[ entry.producer ] )
+      {
+        printf( "FAIL producer %d: message %d after %d\n", entry.producer, entry.index, last[ entry.producer ] );
+        failures++;
+      }
+
+      last[ entry.producer ] = entry.index;
+      delivered++;
+    }
+  }
+
+  const size_t sent    = static_cast<size_t>( Producers ) * Messages;
+  const size_t dropped = uLog::getQueueDropCount();
+
+  if ( ( delivered + dropped ) != sent )
+  {
+    printf( "FAIL %zu delivered and %zu dropped of %zu sent\n", delivered, dropped, sent );
+    failures++;
+  }
+
+  /*------------------------------------------------
+  With the drain stopped, panicFlush() must be able to
+  merge out what is left in the queues itself
+  ------------------------------------------------*/
+  static constexpr size_t Stranded = 10;
+
+  for ( size_t i = 0; i < Stranded; i++ )
+  {
+    uLog::log( uLog::Level::LVL_INFO, "stranded", 8 );
+  }
+
+  uLog::panicFlush();
+
+  if ( capture->panicked != Stranded )
+  {
+    printf( "FAIL panicFlush delivered %zu of %zu queued messages\n", capture->panicked, Stranded );
+    failures++;
+  }
+
+  printf( "%zu delivered, %zu dropped, %zu failures\n", delivered, dropped, failures );
+  return failures ? 1 : 0;
+}
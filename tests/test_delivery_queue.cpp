@@ -0,0 +1,192 @@
+/********************************************************************************
+ *  File Name:
+ *    test_delivery_queue.cpp
+ *
+ *  Description:
+ *    Checks the delivery queues feeding slow sinks. Under each backpressure
+ *    policy, what a sink receives plus what it counts as dropped must add up
+ *    to what was sent, in the order it was sent. A dedicated sink whose own
+ *    worker isn't running must still be drained while a pool worker is.
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* C++ Includes */
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+/* uLog Includes */
+#include <uLog/ulog.hpp>
+
+#if ( ULOG_ENABLE_DELIVERY_WORKERS != 1 )
+#error "test_delivery_queue needs ULOG_ENABLE_DELIVERY_WORKERS"
+#endif
+
+/*-------------------------------------------------------------------------------
+Constants
+-------------------------------------------------------------------------------*/
+static constexpr int Messages = 500;
+
+/*-------------------------------------------------------------------------------
+Static Data
+-------------------------------------------------------------------------------*/
+static size_t sFailures = 0;
+static int sNext        = 0;
+
+/*-------------------------------------------------------------------------------
+Classes
+-------------------------------------------------------------------------------*/
+/**
+ *  Sink that takes a while over each message and checks they arrive in order
+ */
+class SlowSink : public uLog::SinkInterface
+{
+public:
+  std::atomic<size_t> received{ 0 };
+  size_t misordered = 0;
+  int last          = -1;
+
+  uLog::Result open() override
+  {
+    return uLog::Result::RESULT_SUCCESS;
+  }
+
+  uLog::Result close() override
+  {
+    return uLog::Result::RESULT_SUCCESS;
+  }
+
+  uLog::Result flush() override
+  {
+    return uLog::Result::RESULT_SUCCESS;
+  }
+
+  uLog::IOType getIOType() override
+  {
+    return uLog::IOType::CONSOLE_SINK;
+  }
+
+  uLog::Result log( const uLog::Level level, const void *const message, const size_t length ) override
+  {
+    ( void )level;
+    char text[ 16 ] = {};
+    memcpy( text, message, std::min( length, sizeof( text ) - 1 ) );
+
+    const int index = atoi( text );
+    misordered += ( index <= last ) ? 1 : 0;
+    last = index;
+
+    std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+    received.fetch_add( 1, std::memory_order_release );
+    return uLog::Result::RESULT_SUCCESS;
+  }
+};
+
+/*-------------------------------------------------------------------------------
+Static Functions
+-------------------------------------------------------------------------------*/
+/**
+ *  Logs a run of numbered messages
+ *
+ *  @param[in]  count     Number of messages
+ */
+static void logNumbered( const int count )
+{
+  for ( int i = 0; i < count; i++ )
+  {
+    char text[ 16 ];
+    const int length = snprintf( text, sizeof( text ), "%d", sNext++ );
+    uLog::log( uLog::Level::LVL_INFO, text, length );
+  }
+}
+
+/**
+ *  Sends messages to a queued sink under one policy and checks nothing went
+ *  missing or out of order
+ *
+ *  @param[in]  name      Name of the case
+ *  @param[in]  policy    Backpressure policy for the sink
+ *  @param[in]  options   Registration options
+ */
+static void checkPolicy( const char *const name, const uLog::BackpressurePolicy policy, const uLog::Config options )
+{
+  auto slow             = std::make_shared<SlowSink>();
+  uLog::SinkHandle sink = slow;
+  sink->setLogLevel( uLog::Level::LVL_INFO );
+  sink->setBackpressure( policy );
+  sink->enable();
+
+  if ( uLog::registerSink( sink, options ) != uLog::Result::RESULT_SUCCESS )
+  {
+    printf( "FAIL %s: could not register the sink\n", name );
+    sFailures++;
+    return;
+  }
+
+  slow->last = sNext - 1;
+  logNumbered( Messages );
+  uLog::flush();
+
+  const size_t received = slow->received.load( std::memory_order_acquire );
+  const size_t dropped  = sink->getDropCount();
+  const size_t backlog  = uLog::getDeliveryBacklog( sink );
+
+  if ( ( received + dropped ) != Messages )
+  {
+    printf( "FAIL %s: %zu received and %zu dropped of %d sent\n", name, received, dropped, Messages );
+    sFailures++;
+  }
+
+  if ( backlog || slow->misordered )
+  {
+    printf( "FAIL %s: %zu left queued, %zu out of order\n", name, backlog, slow->misordered );
+    sFailures++;
+  }
+
+  printf( "%s: %zu received, %zu dropped\n", name, received, dropped );
+  uLog::removeSink( sink );
+}
+
+int main()
+{
+  uLog::initialize();
+  uLog::setGlobalLogLevel( uLog::Level::LVL_INFO );
+
+  /*------------------------------------------------
+  A watchdog, as the failure being tested is a hang
+  ------------------------------------------------*/
+  std::thread( [] {
+    std::this_thread::sleep_for( std::chrono::seconds( 60 ) );
+    printf( "FAIL timed out\n" );
+    fflush( stdout );
+    std::_Exit( 1 );
+  } ).detach();
+
+  std::thread pool( [] { uLog::deliveryWorkerThread( nullptr ); } );
+
+  checkPolicy( "drop newest", { uLog::Backpressure::DROP_NEWEST, 0 }, uLog::CFG_DELIVERY_QUEUED );
+  checkPolicy( "drop oldest", { uLog::Backpressure::DROP_OLDEST, 0 }, uLog::CFG_DELIVERY_QUEUED );
+  checkPolicy( "block", { uLog::Backpressure::BLOCK, uLog::WaitForever }, uLog::CFG_DELIVERY_QUEUED );
+
+  /*------------------------------------------------
+  No worker of its own: the pool must leave it alone
+  and the producer must drain it instead of waiting
+  ------------------------------------------------*/
+  checkPolicy( "dedicated, no worker", { uLog::Backpressure::BLOCK, uLog::WaitForever }, uLog::CFG_DELIVERY_DEDICATED );
+
+  uLog::stopDeliveryWorkers();
+  pool.join();
+
+  /*------------------------------------------------
+  And with no workers at all
+  ------------------------------------------------*/
+  checkPolicy( "no workers", { uLog::Backpressure::BLOCK, uLog::WaitForever }, uLog::CFG_DELIVERY_QUEUED );
+
+  printf( "%zu failures\n", sFailures );
+  return sFailures ? 1 : 0;
+}
@@ -0,0 +1,186 @@
+/********************************************************************************
+ *  File Name:
+ *    test_format.cpp
+ *
+ *  Description:
+ *    Differential test of the compile time checked formatter against snprintf.
+ *    Every conversion is run over edge cases and random values, and any output
+ *    that differs from the C library is reported.
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* C++ Includes */
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+
+/* uLog Includes */
+#include <uLog/format.hpp>
+
+/*-------------------------------------------------------------------------------
+Static Data
+-------------------------------------------------------------------------------*/
+static size_t sChecks   = 0;
+static size_t sFailures = 0;
+
+/*-------------------------------------------------------------------------------
+Static Functions
+-------------------------------------------------------------------------------*/
+/**
+ *  Formats one value both ways and records any difference
+ *
+ *  @param[in]  fmt       Format string from ULOG_FMT()
+ *  @param[in]  value     Value to format
+ */
+template<typename F, typename T>
+static void check( F fmt, const T value )
+{
+  char expected[ 512 ];
+  char actual[ 512 ];
+
+  const int reference = snprintf( expected, sizeof( expected ), F::view().data(), value );
+  const size_t length = uLog::Format::format( actual, sizeof( actual ), fmt, value );
+
+  sChecks++;
+  if ( ( reference < 0 ) || ( length != static_cast<size_t>( reference ) ) || strcmp( expected, actual ) )
+  {
+    sFailures++;
+    if ( sFailures <= 20 )
+    {
+      printf( "FAIL \"%s\": expected \"%s\", got \"%s\"\n", F::view().data(), expected, actual );
+    }
+  }
+}
+
+/**
+ *  Runs a value through every FIXED conversion under test
+ *
+ *  @param[in]  value     Value to format
+ */
+static void checkFixed( const double value )
+{
+  check( ULOG_FMT( "%f" ), value );
+  check( ULOG_FMT( "%.0f" ), value );
+  check( ULOG_FMT( "%.1f" ), value );
+  check( ULOG_FMT( "%.2f" ), value );
+  check( ULOG_FMT( "%.3f" ), value );
+  check( ULOG_FMT( "%.4f" ), value );
+  check( ULOG_FMT( "%.5f" ), value );
+  check( ULOG_FMT( "%.7f" ), value );
+  check( ULOG_FMT( "%.8f" ), value );
+  check( ULOG_FMT( "%.9f" ), value );
+  check( ULOG_FMT( "%.12f" ), value );
+  check( ULOG_FMT( "%#.0f" ), value );
+  check( ULOG_FMT( "%+10.3f" ), value );
+  check( ULOG_FMT( "% -12.2f" ), value );
+  check( ULOG_FMT( "%015.4f" ), value );
+}
+
+/**
+ *  Runs a value through every integer conversion under test
+ *
+ *  @param[in]  value     Value to format
+ */
+static void checkInteger( const long long value )
+{
+  const unsigned long long bits = static_cast<unsigned long long>( value );
+
+  check( ULOG_FMT( "%lld" ), value );
+  check( ULOG_FMT( "%+8lld" ), value );
+  check( ULOG_FMT( "%-8lld|" ), value );
+  check( ULOG_FMT( "%08lld" ), value );
+  check( ULOG_FMT( "%.5lld" ), value );
+  check( ULOG_FMT( "% lld" ), value );
+  check( ULOG_FMT( "%llu" ), bits );
+  check( ULOG_FMT( "%llx" ), bits );
+  check( ULOG_FMT( "%#llX" ), bits );
+  check( ULOG_FMT( "%#llo" ), bits );
+  check( ULOG_FMT( "%020llx" ), bits );
+  check( ULOG_FMT( "%.0llu" ), bits );
+}
+
+int main()
+{
+  std::mt19937_64 rng( 0x756c6f67u );
+
+  /*------------------------------------------------
+  Values whose exact binary form sits just beside a
+  rounding tie, plus the usual edge cases
+  ------------------------------------------------*/
+  static constexpr double edges[] = { 0.0,    -0.0,        5e-10,     1.5e-9,          9.9999999995, 0.5,   1.5,    2.5,
+                                      0.125,  0.375,       1.005,     2.675,           0.045,        1e-9,  1e17,   999999999999999999.0,
+                                      1e18,   -1e18,       123.456,   -0.0000005,      0.9999995,    1e300, 1e-300, 4.35,
+                                      0.015,  1234567.891, 1.0 / 3.0, 2.0 / 3.0,       -7.25,        99.95, 0.05,   0.25 };
+
+  for ( const double value : edges )
+  {
+    checkFixed( value );
+    checkFixed( std::nextafter( value, 0.0 ) );
+    checkFixed( std::nextafter( value, 2.0 * value + 1.0 ) );
+  }
+
+  checkFixed( std::numeric_limits<double>::infinity() );
+  checkFixed( -std::numeric_limits<double>::infinity() );
+  checkFixed( std::numeric_limits<double>::quiet_NaN() );
+
+  /*------------------------------------------------
+  Decimal looking values, which land near ties far
+  more often than random bit patterns do
+  ------------------------------------------------*/
+  std::uniform_int_distribution<int64_t> mantissa( -2000000000000ll, 2000000000000ll );
+  std::uniform_int_distribution<int> exponent( 0, 12 );
+
+  for ( size_t i = 0; i < 100000; i++ )
+  {
+    const double value = static_cast<double>( mantissa( rng ) ) / std::pow( 10.0, exponent( rng ) );
+    checkFixed( value );
+    checkFixed( value + 0.5 * std::pow( 10.0, -exponent( rng ) ) );
+  }
+
+  /*------------------------------------------------
+  Random magnitudes across the integer fast path
+  ------------------------------------------------*/
+  std::uniform_real_distribution<double> scale( -12.0, 18.0 );
+  std::uniform_real_distribution<double> unit( -1.0, 1.0 );
+
+  for ( size_t i = 0; i < 100000; i++ )
+  {
+    checkFixed( unit( rng ) * std::pow( 10.0, scale( rng ) ) );
+  }
+
+  /*------------------------------------------------
+  Integers, characters, strings and pointers
+  ------------------------------------------------*/
+  static constexpr long long integers[] = { 0, 1, -1, 7, 8, 10, 255, -255, std::numeric_limits<long long>::min(),
+                                            std::numeric_limits<long long>::max() };
+
+  for ( const long long value : integers )
+  {
+    checkInteger( value );
+  }
+
+  for ( size_t i = 0; i < 20000; i++ )
+  {
+    checkInteger( static_cast<long long>( rng() ) >> ( rng() % 64 ) );
+  }
+
+  check( ULOG_FMT( "%c" ), 'x' );
+  check( ULOG_FMT( "[%-4c]" ), 'y' );
+  check( ULOG_FMT( "[%4c]" ), 'z' );
+  check( ULOG_FMT( "%s" ), "text" );
+  check( ULOG_FMT( "[%8s]" ), "text" );
+  check( ULOG_FMT( "[%-8s]" ), "text" );
+  check( ULOG_FMT( "[%.2s]" ), "text" );
+  check( ULOG_FMT( "[%8.0s]" ), "text" );
+  check( ULOG_FMT( "[%s]" ), "" );
+  check( ULOG_FMT( "%p" ), static_cast<const void *>( &sChecks ) );
+  check( ULOG_FMT( "[%20p]" ), static_cast<const void *>( &sChecks ) );
+  check( ULOG_FMT( "100%% %d" ), 42 );
+
+  printf( "%zu checks, %zu failures\n", sChecks, sFailures );
+  return sFailures ? 1 : 0;
+}
@@ -0,0 +1,500 @@
+#!/usr/bin/env python3
+# ********************************************************************************
+#   File Name:
+#     ulog_decode.py
+#
+#   Description:
+#     Host side companion to uLog/deferred.hpp.
+#
+#       extract   Scans sources for ULOG_DEFERRED() call sites and writes the
+#                 format string table, keyed by the same FNV-1a hash the device
+#                 computes at compile time.
+#       decode    Rebuilds text from a stream of deferred records using a table
+#                 produced by 'extract'.
+#       records   Streams a capture of binary framed records (uLog/record.hpp)
+#                 back into text, optionally filtered by level and module.
+#       unpack    Decompresses a stream of compressed frames written by a sink
+#                 with compression enabled (uLog/compress/lz_block.hpp).
+#
+#   2026 | Brandon Braun | brandonbraun653@gmail.com
+# ********************************************************************************
+
+import argparse
+import datetime
+import json
+import os
+import re
+import struct
+import sys
+
+SOURCE_EXTENSIONS = (".c", ".cc", ".cpp", ".cxx", ".h", ".hh", ".hpp", ".hxx")
+DEFERRED_MACRO = "ULOG_DEFERRED"
+LEVEL_NAMES = ["TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"]
+
+# Must match uLog::Deferred::ArgType
+ARG_SINT, ARG_UINT, ARG_CHAR, ARG_F32, ARG_F64, ARG_STRING, ARG_POINTER = range(7)
+
+HEADER = struct.Struct("<IBIB")
+
+# Must match uLog/record.hpp
+RECORD_MAGIC = 0xB5
+RECORD_HEADER = struct.Struct("<BBHHIQ")
+RECORD_TEXT, RECORD_DEFERRED, RECORD_CALIBRATION = range(3)
+CALIBRATION = struct.Struct("<QQQ")
+
+# Must match uLog/compress/lz_block.hpp
+FRAME_MAGIC = 0x315A4C55
+FRAME_STORED = 0x80000000
+FRAME_HEADER = struct.Struct("<III")
+
+PRINTF_SPEC = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<prec>\*|\d*))?"
+    r"(?P<length>hh|h|ll|l|j|z|t|L)?(?P<conv>[diouxXeEfFgGcsp%])"
+)
+
+
+# --------------------------------------------------------------------------------
+# Format string table extraction
+# --------------------------------------------------------------------------------
+def fnv1a_32(data: bytes) -> int:
+    value = 2166136261
+    for byte in data:
+        value ^= byte
+        value = (value * 16777619) & 0xFFFFFFFF
+    return value
+
+
+def unescape_c_string(body: str) -> bytes:
+    out = bytearray()
+    i = 0
+    simple = {"n": 10, "t": 9, "r": 13, "a": 7, "b": 8, "f": 12, "v": 11, "\\": 92, "'": 39, '"': 34, "?": 63}
+    while i < len(body):
+        ch = body[i]
+        if ch != "\\":
+            out += ch.encode("utf-8")
+            i += 1
+            continue
+        i += 1
+        esc = body[i]
+        if esc in simple:
+            out.append(simple[esc])
+            i += 1
+        elif esc == "x":
+            match = re.match(r"[0-9a-fA-F]+", body[i + 1:])
+            out.append(int(match.group(0), 16) & 0xFF)
+            i += 1 + len(match.group(0))
+        else:
+            match = re.match(r"[0-7]{1,3}", body[i:])
+            out.append(int(match.group(0), 8) & 0xFF)
+            i += len(match.group(0))
+    return bytes(out)
+
+
+def skip_first_argument(text: str, pos: int) -> int:
+    """Returns the index just past the top level comma ending the first macro argument"""
+    depth = 0
+    while pos < len(text):
+        ch = text[pos]
+        if ch in "([{":
+            depth += 1
+        elif ch in ")]}":
+            if depth == 0:
+                return -1
+            depth -= 1
+        elif ch == "," and depth == 0:
+            return pos + 1
+        pos += 1
+    return -1
+
+
+def read_string_literals(text: str, pos: int):
+    """Reads one or more adjacent string literals, returning (bytes, end) or (None, pos)"""
+    literal = re.compile(r'\s*"((?:[^"\\\n]|\\.)*)"', re.S)
+    parts = []
+    while True:
+        match = literal.match(text, pos)
+        if not match:
+            break
+        parts.append(match.group(1))
+        pos = match.end()
+    if not parts:
+        return None, pos
+    return b"".join(unescape_c_string(p) for p in parts), pos
+
+
+def extract_formats(paths):
+    table = {}
+    call = re.compile(r"\b" + DEFERRED_MACRO + r"\s*\(")
+
+    for root_path in paths:
+        for root, _, files in os.walk(root_path) if os.path.isdir(root_path) else [("", None, [root_path])]:
+            for name in files:
+                if not name.endswith(SOURCE_EXTENSIONS):
+                    continue
+                path = os.path.join(root, name)
+                with open(path, "r", encoding="utf-8", errors="replace") as f:
+                    text = f.read()
+
+                for match in call.finditer(text):
+                    start = skip_first_argument(text, match.end())
+                    if start < 0:
+                        continue
+                    fmt, _ = read_string_literals(text, start)
+                    if fmt is None:
+                        continue
+
+                    key = "0x%08x" % fnv1a_32(fmt)
+                    line = text.count("\n", 0, match.start()) + 1
+                    entry = {"format": fmt.decode("utf-8", errors="replace"), "file": path, "line": line}
+
+                    if key in table and table[key]["format"] != entry["format"]:
+                        raise SystemExit("Format ID collision %s between %s:%d and %s:%d" %
+                                         (key, table[key]["file"], table[key]["line"], path, line))
+                    table.setdefault(key, entry)
+    return table
+
+
+# --------------------------------------------------------------------------------
+# Record decoding
+# --------------------------------------------------------------------------------
+def read_varint(data: bytes, pos: int):
+    value = 0
+    shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, pos
+
+
+def decode_args(data: bytes):
+    args = []
+    pos = 0
+    while pos < len(data):
+        tag = data[pos]
+        pos += 1
+        if tag == ARG_SINT:
+            raw, pos = read_varint(data, pos)
+            args.append((raw >> 1) ^ -(raw & 1))
+        elif tag in (ARG_UINT, ARG_POINTER):
+            value, pos = read_varint(data, pos)
+            args.append(value)
+        elif tag == ARG_CHAR:
+            args.append(chr(data[pos]))
+            pos += 1
+        elif tag == ARG_F32:
+            args.append(struct.unpack_from("<f", data, pos)[0])
+            pos += 4
+        elif tag == ARG_F64:
+            args.append(struct.unpack_from("<d", data, pos)[0])
+            pos += 8
+        elif tag == ARG_STRING:
+            length = data[pos]
+            args.append(data[pos + 1:pos + 1 + length].decode("utf-8", errors="replace"))
+            pos += 1 + length
+        else:
+            raise ValueError("unknown argument tag %d" % tag)
+    return args
+
+
+def render_printf(fmt: str, args) -> str:
+    """Applies C printf semantics closely enough for log output"""
+    args = list(args)
+
+    def take():
+        return args.pop(0) if args else "<missing>"
+
+    def convert(match):
+        conv = match.group("conv")
+        if conv == "%":
+            return "%"
+
+        width = match.group("width") or ""
+        prec = match.group("prec")
+        if width == "*":
+            width = str(take())
+        if prec == "*":
+            prec = str(take())
+        spec = "%" + match.group("flags") + width + ("." + prec if prec is not None else "")
+
+        value = take()
+        if isinstance(value, str) and value == "<missing>":
+            return value
+
+        try:
+            if conv in "di":
+                return (spec + "d") % int(value)
+            if conv in "uoxX":
+                bits = 64 if match.group("length") in ("l", "ll", "j", "z", "t") else 32
+                return (spec + ("d" if conv == "u" else conv)) % (int(value) & ((1 << bits) - 1))
+            if conv in "eEfFgG":
+                return (spec + conv) % float(value)
+            if conv == "c":
+                return (spec + "s") % (value if isinstance(value, str) else chr(value))
+            if conv == "s":
+                return (spec + "s") % value
+            if conv == "p":
+                return "0x%x" % value
+        except (TypeError, ValueError):
+            pass
+        return "<bad %%%s: %r>" % (conv, value)
+
+    return PRINTF_SPEC.sub(convert, fmt)
+
+
+def decode_deferred_record(table, data: bytes):
+    """Decodes one complete deferred record into (timestamp, level, text)"""
+    fmt_id, level, timestamp, arg_len = HEADER.unpack_from(data, 0)
+    args = decode_args(data[HEADER.size:HEADER.size + arg_len])
+    entry = table.get("0x%08x" % fmt_id)
+
+    if entry is None:
+        text = "<unknown format 0x%08x> %s" % (fmt_id, " ".join(repr(a) for a in args))
+    else:
+        text = render_printf(entry["format"], args)
+    return timestamp, level, text
+
+
+def level_name(level: int) -> str:
+    return LEVEL_NAMES[level] if level < len(LEVEL_NAMES) else "L%d" % level
+
+
+def decode_stream(table, stream, out):
+    data = stream.read()
+    pos = 0
+    while pos + HEADER.size <= len(data):
+        arg_len = data[pos + HEADER.size - 1]
+        end = pos + HEADER.size + arg_len
+        if end > len(data):
+            break
+        timestamp, level, text = decode_deferred_record(table, data[pos:end])
+        out.write("[%10u] %-5s %s\n" % (timestamp, level_name(level), text.rstrip("\n")))
+        pos = end
+
+    if pos != len(data):
+        sys.stderr.write("warning: %d trailing bytes could not be decoded\n" % (len(data) - pos))
+
+
+# --------------------------------------------------------------------------------
+# Binary record streams
+# --------------------------------------------------------------------------------
+def iter_records(stream, chunk_size=1 << 20):
+    """Yields (type, level, module, sequence, tick, payload) without reading the whole stream"""
+    buf = bytearray()
+    skipped = 0
+
+    while True:
+        chunk = stream.read(chunk_size)
+        buf += chunk
+        pos = 0
+
+        while len(buf) - pos >= RECORD_HEADER.size:
+            magic, type_level, length, module, sequence, tick = RECORD_HEADER.unpack_from(buf, pos)
+            rtype, level = type_level >> 4, type_level & 0x0F
+
+            # Step a byte at a time to find the next header after corruption
+            if magic != RECORD_MAGIC or rtype > RECORD_CALIBRATION or level >= len(LEVEL_NAMES):
+                pos += 1
+                skipped += 1
+                continue
+
+            end = pos + RECORD_HEADER.size + length
+            if end > len(buf):
+                break
+            yield rtype, level, module, sequence, tick, bytes(buf[pos + RECORD_HEADER.size:end])
+            pos = end
+
+        del buf[:pos]
+        if not chunk:
+            break
+
+    if skipped:
+        sys.stderr.write("warning: skipped %d bytes that were not part of a record\n" % skipped)
+    if buf:
+        sys.stderr.write("warning: %d trailing bytes could not be decoded\n" % len(buf))
+
+
+class TickClock:
+    """Converts record ticks into text once a calibration record has been seen"""
+
+    def __init__(self):
+        self.hz = None
+        self.tick = 0
+        self.unix_ns = 0
+
+    def calibrate(self, payload: bytes):
+        self.hz, self.tick, self.unix_ns = CALIBRATION.unpack_from(payload, 0)
+        self.hz = self.hz or 1
+
+    def format(self, tick: int) -> str:
+        if self.hz is None:
+            return "%20u" % tick
+        ns = self.unix_ns + ((tick - self.tick) * 1000000000) // self.hz
+        if not self.unix_ns:
+            return "%17.9f" % (ns / 1e9)
+        stamp = datetime.datetime.fromtimestamp(ns // 1000000000, datetime.timezone.utc)
+        return "%s.%09dZ" % (stamp.strftime("%Y-%m-%dT%H:%M:%S"), ns % 1000000000)
+
+
+def parse_level(text: str) -> int:
+    if text.upper() in LEVEL_NAMES:
+        return LEVEL_NAMES.index(text.upper())
+    return int(text, 0)
+
+
+def decode_records(table, stream, out, min_level=0, modules=None, show_seq=False):
+    clock = TickClock()
+
+    for rtype, level, module, sequence, tick, payload in iter_records(stream):
+        if rtype == RECORD_CALIBRATION:
+            clock.calibrate(payload)
+            continue
+        if level < min_level or (modules is not None and module not in modules):
+            continue
+
+        if rtype == RECORD_DEFERRED and table is not None:
+            text = decode_deferred_record(table, payload)[2]
+        elif rtype == RECORD_DEFERRED:
+            text = "<deferred %s>" % payload.hex()
+        else:
+            text = payload.decode("utf-8", errors="replace")
+
+        prefix = "%10u " % sequence if show_seq else ""
+        out.write("%s%s %-5s [%u] %s\n" % (prefix, clock.format(tick), level_name(level), module, text.rstrip("\n")))
+
+
+# --------------------------------------------------------------------------------
+# Compressed frames
+# --------------------------------------------------------------------------------
+def lz_block_decode(src: bytes, raw_length: int) -> bytes:
+    """Decodes one block in the LZ4 block format"""
+    out = bytearray()
+    pos = 0
+
+    def run_length(pos, length):
+        while True:
+            byte = src[pos]
+            pos += 1
+            length += byte
+            if byte != 255:
+                return pos, length
+
+    while pos < len(src):
+        token = src[pos]
+        pos += 1
+
+        literals = token >> 4
+        if literals == 15:
+            pos, literals = run_length(pos, literals)
+        out += src[pos:pos + literals]
+        pos += literals
+        if pos >= len(src):
+            break
+
+        offset = src[pos] | (src[pos + 1] << 8)
+        pos += 2
+        match = token & 0x0F
+        if match == 15:
+            pos, match = run_length(pos, match)
+        match += 4
+
+        start = len(out) - offset
+        if offset <= 0 or start < 0:
+            raise ValueError("bad match offset %d" % offset)
+        if offset >= match:
+            out += out[start:start + match]
+        else:
+            for i in range(match):
+                out.append(out[start + i])
+
+    if len(out) != raw_length:
+        raise ValueError("block decoded to %d bytes, expected %d" % (len(out), raw_length))
+    return bytes(out)
+
+
+def unpack_stream(stream, out):
+    """Decompresses frames until the input ends or a frame is incomplete"""
+    frames = 0
+    while True:
+        header = stream.read(FRAME_HEADER.size)
+        if len(header) < FRAME_HEADER.size:
+            if header:
+                sys.stderr.write("warning: truncated frame header after %d frames\n" % frames)
+            break
+
+        magic, raw_length, info = FRAME_HEADER.unpack(header)
+        if magic != FRAME_MAGIC:
+            raise SystemExit("error: bad frame magic 0x%08x after %d frames" % (magic, frames))
+
+        stored_length = info & ~FRAME_STORED
+        body = stream.read(stored_length)
+        if len(body) < stored_length:
+            sys.stderr.write("warning: truncated frame after %d complete frames\n" % frames)
+            break
+
+        out.write(body if info & FRAME_STORED else lz_block_decode(body, raw_length))
+        frames += 1
+
+
+def load_table(path):
+    with open(path, "r", encoding="utf-8") as f:
+        return json.load(f)["formats"]
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="uLog deferred format tooling")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    extract = commands.add_parser("extract", help="build a format string table from sources")
+    extract.add_argument("paths", nargs="+", help="source files or directories to scan")
+    extract.add_argument("-o", "--output", required=True, help="table file to write")
+
+    decode = commands.add_parser("decode", help="decode a stream of deferred records")
+    decode.add_argument("input", help="binary capture, or '-' for stdin")
+    decode.add_argument("-t", "--table", required=True, help="table from 'extract'")
+
+    records = commands.add_parser("records", help="decode a stream of binary framed records")
+    records.add_argument("input", help="binary capture, or '-' for stdin")
+    records.add_argument("-t", "--table", help="table from 'extract', needed to render deferred records")
+    records.add_argument("-l", "--level", type=parse_level, default=0,
+                         help="lowest level to show, by name or number")
+    records.add_argument("-m", "--module", type=lambda v: int(v, 0), action="append",
+                         help="only show this module ID, may be repeated")
+    records.add_argument("--seq", action="store_true", help="prefix each record with its sequence number")
+
+    unpack = commands.add_parser("unpack", help="decompress a stream of compressed frames")
+    unpack.add_argument("input", help="compressed capture, or '-' for stdin")
+    unpack.add_argument("-o", "--output", help="file to write, defaults to stdout")
+
+    args = parser.parse_args(argv)
+
+    if args.command == "extract":
+        table = extract_formats(args.paths)
+        with open(args.output, "w", encoding="utf-8") as f:
+            json.dump({"version": 1, "formats": table}, f, indent=2, sort_keys=True)
+        print("Extracted %d format strings to %s" % (len(table), args.output))
+    elif args.command == "decode":
+        table = load_table(args.table)
+        stream = sys.stdin.buffer if args.input == "-" else open(args.input, "rb")
+        with stream:
+            decode_stream(table, stream, sys.stdout)
+    elif args.command == "records":
+        table = load_table(args.table) if args.table else None
+        stream = sys.stdin.buffer if args.input == "-" else open(args.input, "rb")
+        modules = set(args.module) if args.module else None
+        with stream:
+            decode_records(table, stream, sys.stdout, args.level, modules, args.seq)
+    elif args.command == "unpack":
+        stream = sys.stdin.buffer if args.input == "-" else open(args.input, "rb")
+        out = open(args.output, "wb") if args.output else sys.stdout.buffer
+        with stream:
+            unpack_stream(stream, out)
+        if args.output:
+            out.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+# ********************************************************************************
+#   File Name:
+#     ulog_ring_reader.py
+#
+#   Description:
+#     Recovers the records held in a MappedRingSink file, oldest first. Works on
+#     the file left behind by a crashed process. Must run on a host with the
+#     same endianness as the device that wrote the ring.
+#
+#   2026 | Brandon Braun | brandonbraun653@gmail.com
+# ********************************************************************************
+
+import argparse
+import datetime
+import struct
+import sys
+
+RING_MAGIC = 0x47524C55
+RING_VERSION = 3
+CALIBRATION_FLAG = 0x80000000
+DATA_OFFSET = 64
+HEADER = struct.Struct("=IIQQQQQQQ")
+RECORD_HEADER = struct.Struct("=IIQ")
+CALIBRATION = struct.Struct("=QQQ")
+
+
+def ring_read(data: bytes, capacity: int, offset: int, length: int) -> bytes:
+    start = offset % capacity
+    first = min(length, capacity - start)
+    return data[start:start + first] + data[:length - first]
+
+
+class Calibration:
+    """Converts raw record ticks into time, using the pair stored by the writer"""
+
+    def __init__(self, hz: int, tick: int, unix_ns: int):
+        self.hz = hz or 1
+        self.tick = tick
+        self.unix_ns = unix_ns
+
+    def to_ns(self, tick: int) -> int:
+        return self.unix_ns + ((tick - self.tick) * 1000000000) // self.hz
+
+    def format(self, tick: int) -> str:
+        ns = self.to_ns(tick)
+        if not self.unix_ns:
+            return "%17.9f" % (ns / 1e9)
+        stamp = datetime.datetime.fromtimestamp(ns // 1000000000, datetime.timezone.utc)
+        return "%s.%09dZ" % (stamp.strftime("%Y-%m-%dT%H:%M:%S"), ns % 1000000000)
+
+
+def read_ring(path: str):
+    """Yields the ring's Calibration, then (sequence, tick, payload) for every intact record, with a new
+    Calibration wherever a resuming process changed it"""
+    with open(path, "rb") as f:
+        raw = f.read()
+
+    if len(raw) < DATA_OFFSET:
+        raise SystemExit("%s: too small to be a ring file" % path)
+
+    magic, version, capacity, head, tail, sequence, tick_hz, cal_tick, cal_unix_ns = HEADER.unpack_from(raw, 0)
+    if magic != RING_MAGIC or version not in (2, RING_VERSION):
+        raise SystemExit("%s: not a uLog ring file (magic 0x%08x, version %d)" % (path, magic, version))
+    if head < tail or head - tail > capacity or len(raw) < DATA_OFFSET + capacity:
+        raise SystemExit("%s: corrupt ring header" % path)
+
+    yield Calibration(tick_hz, cal_tick, cal_unix_ns)
+
+    data = raw[DATA_OFFSET:DATA_OFFSET + capacity]
+    offset = tail
+
+    while offset < head:
+        length, seq, tick = RECORD_HEADER.unpack(ring_read(data, capacity, offset, RECORD_HEADER.size))
+        marker = length & CALIBRATION_FLAG
+        length &= ~CALIBRATION_FLAG
+        if offset + RECORD_HEADER.size + length > head:
+            sys.stderr.write("warning: truncated record at offset %d\n" % offset)
+            break
+        payload = ring_read(data, capacity, offset + RECORD_HEADER.size, length)
+        if marker:
+            yield Calibration(*CALIBRATION.unpack(payload))
+        else:
+            yield seq, tick, payload
+        offset += RECORD_HEADER.size + length
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Recover records from a uLog MappedRingSink file")
+    parser.add_argument("ring", help="ring file written by MappedRingSink")
+    parser.add_argument("--raw", action="store_true",
+                        help="write payloads back to back on stdout, e.g. to pipe into ulog_decode.py")
+    parser.add_argument("--seq", action="store_true", help="prefix each text record with its sequence number")
+    parser.add_argument("--time", action="store_true",
+                        help="prefix each text record with its UTC timestamp, or seconds since boot if the "
+                             "writer had no wall clock")
+    args = parser.parse_args(argv)
+
+    out = sys.stdout.buffer
+    calibration = None
+    for record in read_ring(args.ring):
+        if isinstance(record, Calibration):
+            calibration = record
+            continue
+        seq, tick, payload = record
+        if args.raw:
+            out.write(payload)
+            continue
+        if args.time:
+            out.write(calibration.format(tick).encode() + b" ")
+        if args.seq:
+            out.write(b"%10u " % seq)
+        out.write(payload if payload.endswith(b"\n") else payload + b"\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,191 @@
+/********************************************************************************
+ *  File Name:
+ *    coalesce.hpp
+ *
+ *  Description:
+ *    Tracks the last message handed to a sink so that byte identical repeats
+ *    can be folded into a single "last message repeated N times" summary.
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_COALESCE_HPP
+#define MICRO_LOGGER_COALESCE_HPP
+
+/* C++ Includes */
+#include <cstddef>
+#include <cstdint>
+
+/* uLog Includes */
+#include <uLog/config.hpp>
+#include <uLog/types.hpp>
+
+namespace uLog
+{
+  /**
+   *  Per sink duplicate tracker. Not thread safe; callers hold the sink lock.
+   */
+  class Coalescer
+  {
+  public:
+    /**
+     *  Hashes a message with 64-bit FNV-1a
+     *
+     *  @param[in]  message   Message bytes
+     *  @param[in]  length    Number of bytes
+     *  @return uint64_t
+     */
+    static uint64_t hash( const void *const message, const size_t length )
+    {
+      const uint8_t *bytes = static_cast<const uint8_t *>( message );
+      uint64_t result      = 0xCBF29CE484222325ull;
+
+      for ( size_t i = 0; i < length; i++ )
+      {
+        result = ( result ^ bytes[ i ] ) * 0x100000001B3ull;
+      }
+
+      return result;
+    }
+
+    constexpr Coalescer() :
+        mEnabled( true ), mTracking( false ), mModule( DefaultModule ), mLevel( Level::LVL_MAX ), mLength( 0 ), mHash( 0 ),
+        mWindowStart( 0 ), mRepeats( 0 )
+    {
+    }
+
+    /**
+     *  Allows or prevents coalescing. The summary reaches binary sinks as its
+     *  own TEXT record, but the repeats themselves, with their sequence numbers
+     *  and timestamps, are missing from the capture; turn it off where every
+     *  record must be kept.
+     *
+     *  @param[in]  enabled   Whether repeats may be dropped
+     */
+    void setEnabled( const bool enabled )
+    {
+      mEnabled  = enabled;
+      mTracking = false;
+    }
+
+    /**
+     *  Checks if a message repeats the tracked one inside the current window,
+     *  counting it if so.
+     *
+     *  @param[in]  module    Module the message came from
+     *  @param[in]  level     Level of the message
+     *  @param[in]  length    Length of the message
+     *  @param[in]  hash      Result of Coalescer::hash() on the message
+     *  @param[in]  now       Current time in milliseconds
+     *  @return bool          True if the message should be dropped
+     */
+    bool absorb( const ModuleId module, const Level level, const size_t length, const uint64_t hash, const size_t now )
+    {
+      if ( mEnabled && mTracking && ( hash == mHash ) && ( length == mLength ) && ( level == mLevel ) &&
+           ( module == mModule ) && ( ( now - mWindowStart ) < ULOG_COALESCE_WINDOW_MS ) )
+      {
+        mRepeats++;
+        return true;
+      }
+
+      return false;
+    }
+
+    /**
+     *  Starts tracking a new message after it was delivered
+     *
+     *  @param[in]  module    Module the message came from
+     *  @param[in]  level     Level of the message
+     *  @param[in]  length    Length of the message
+     *  @param[in]  hash      Result of Coalescer::hash() on the message
+     *  @param[in]  now       Current time in milliseconds
+     */
+    void track( const ModuleId module, const Level level, const size_t length, const uint64_t hash, const size_t now )
+    {
+      mTracking    = mEnabled;
+      mModule      = module;
+      mLevel       = level;
+      mLength      = length;
+      mHash        = hash;
+      mWindowStart = now;
+      mRepeats     = 0;
+    }
+
+    /**
+     *  Stops tracking, so the next message can't be taken for a repeat. Used
+     *  when a message reached the sink without passing through absorb().
+     */
+    void forget()
+    {
+      mTracking = false;
+    }
+
+    /**
+     *  Checks if repeats are waiting on a window that has already closed
+     *
+     *  @param[in]  now       Current time in milliseconds
+     *  @return bool
+     */
+    bool expired( const size_t now ) const
+    {
+      return mRepeats && ( ( now - mWindowStart ) >= ULOG_COALESCE_WINDOW_MS );
+    }
+
+    /**
+     *  Claims the number of repeats dropped since the last summary. Once they
+     *  have been reported, tracking stops so the next message is shown in full.
+     *
+     *  @return uint32_t
+     */
+    uint32_t takeRepeats()
+    {
+      const uint32_t repeats = mRepeats;
+      mRepeats               = 0;
+      mTracking              = mTracking && !repeats;
+      return repeats;
+    }
+
+    /**
+     *  Checks if a summary is owed for dropped repeats
+     *
+     *  @return bool
+     */
+    bool pending() const
+    {
+      return mRepeats != 0;
+    }
+
+    /**
+     *  Level the pending summary should be logged at
+     *
+     *  @return Level
+     */
+    Level level() const
+    {
+      return mLevel;
+    }
+
+    /**
+     *  Module the pending summary should be tagged with
+     *
+     *  @return ModuleId
+     */
+    ModuleId module() const
+    {
+      return mModule;
+    }
+
+  private:
+    bool mEnabled;
+    bool mTracking;
+    ModuleId mModule;
+    Level mLevel;
+    size_t mLength;
+    uint64_t mHash;
+    size_t mWindowStart;
+    uint32_t mRepeats;
+  };
+}    // namespace uLog
+
+#endif /* !MICRO_LOGGER_COALESCE_HPP */
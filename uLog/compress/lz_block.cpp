@@ -0,0 +1,262 @@
+/********************************************************************************
+ *  File Name:
+ *    lz_block.cpp
+ *
+ *  Description:
+ *    LZ4 block format compressor
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* C++ Includes */
+#include <cstddef>
+#include <cstring>
+
+/* uLog Includes */
+#include <uLog/compress/lz_block.hpp>
+
+namespace uLog::Compress
+{
+  /*-------------------------------------------------------------------------------
+  Constants of the LZ4 block format
+  -------------------------------------------------------------------------------*/
+  static constexpr size_t MinMatch     = 4;     /**< Shortest match that can be encoded */
+  static constexpr size_t LastLiterals = 5;     /**< The final bytes of a block are always literals */
+  static constexpr size_t MatchLimit   = 12;    /**< No match may start in the final bytes of a block */
+  static constexpr size_t MaxOffset    = 65535; /**< Furthest back a match can reference */
+  static constexpr size_t SkipTrigger  = 6;     /**< Misses before the search starts stepping faster */
+
+  static inline uint32_t read32( const uint8_t *const p )
+  {
+    uint32_t value;
+    memcpy( &value, p, sizeof( value ) );
+    return value;
+  }
+
+  static inline void putLE32( uint8_t *const p, const uint32_t value )
+  {
+    p[ 0 ] = static_cast<uint8_t>( value );
+    p[ 1 ] = static_cast<uint8_t>( value >> 8 );
+    p[ 2 ] = static_cast<uint8_t>( value >> 16 );
+    p[ 3 ] = static_cast<uint8_t>( value >> 24 );
+  }
+
+  /**
+   *  Counts how many bytes at 'ip' repeat those at 'ref', stopping at 'limit'.
+   *  Compares a word at a time and finds the first mismatch from the XOR.
+   */
+  static inline size_t countMatch( const uint8_t *ip, const uint8_t *ref, const uint8_t *const limit )
+  {
+    const uint8_t *const start = ip;
+
+    while ( ( limit - ip ) >= static_cast<ptrdiff_t>( sizeof( uint64_t ) ) )
+    {
+      uint64_t a, b;
+      memcpy( &a, ip, sizeof( a ) );
+      memcpy( &b, ref, sizeof( b ) );
+
+      if ( const uint64_t diff = a ^ b; diff )
+      {
+#if defined( __BYTE_ORDER__ ) && ( __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__ )
+        return static_cast<size_t>( ip - start ) + ( __builtin_clzll( diff ) >> 3 );
+#else
+        return static_cast<size_t>( ip - start ) + ( __builtin_ctzll( diff ) >> 3 );
+#endif
+      }
+
+      ip += sizeof( uint64_t );
+      ref += sizeof( uint64_t );
+    }
+
+    while ( ( ip < limit ) && ( *ip == *ref ) )
+    {
+      ip++;
+      ref++;
+    }
+
+    return static_cast<size_t>( ip - start );
+  }
+
+  template<size_t BITS>
+  static inline uint32_t hashSequence( const uint32_t sequence )
+  {
+    return ( sequence * 2654435761u ) >> ( 32 - BITS );
+  }
+
+  /**
+   *  Writes the 255 run continuation of a length that overflowed its nibble
+   */
+  static inline uint8_t *putLength( uint8_t *op, size_t length )
+  {
+    while ( length >= 255 )
+    {
+      *op++ = 255;
+      length -= 255;
+    }
+
+    *op++ = static_cast<uint8_t>( length );
+    return op;
+  }
+
+  /**
+   *  Emits one sequence: literals, then a match unless matchLength is zero
+   *
+   *  @return Next output position, or nullptr if the output is too small
+   */
+  static uint8_t *putSequence( uint8_t *op, const uint8_t *const oend, const uint8_t *const literals, const size_t literalLength,
+                               const size_t offset, const size_t matchLength )
+  {
+    /*------------------------------------------------
+    Worst case space: token, literal run bytes, literals,
+    offset and match run bytes.
+    ------------------------------------------------*/
+    const size_t needed = 1 + ( literalLength / 255 ) + 1 + literalLength + 2 + ( matchLength / 255 ) + 1;
+    if ( static_cast<size_t>( oend - op ) < needed )
+    {
+      return nullptr;
+    }
+
+    const size_t matchCode = matchLength ? ( matchLength - MinMatch ) : 0;
+    uint8_t *token         = op++;
+
+    *token = static_cast<uint8_t>( ( ( literalLength >= 15 ) ? 15 : literalLength ) << 4 );
+    if ( literalLength >= 15 )
+    {
+      op = putLength( op, literalLength - 15 );
+    }
+
+    memcpy( op, literals, literalLength );
+    op += literalLength;
+
+    if ( !matchLength )
+    {
+      return op;
+    }
+
+    *op++ = static_cast<uint8_t>( offset );
+    *op++ = static_cast<uint8_t>( offset >> 8 );
+
+    *token |= static_cast<uint8_t>( ( matchCode >= 15 ) ? 15 : matchCode );
+    if ( matchCode >= 15 )
+    {
+      op = putLength( op, matchCode - 15 );
+    }
+
+    return op;
+  }
+
+  BlockCompressor::BlockCompressor()
+  {
+    mTable.fill( 0 );
+  }
+
+  size_t BlockCompressor::compress( const uint8_t *const src, const size_t length, uint8_t *const dst, const size_t capacity )
+  {
+    const uint8_t *const end = src + length;
+    const uint8_t *anchor    = src;
+    uint8_t *op              = dst;
+    uint8_t *const oend      = dst + capacity;
+
+    /*------------------------------------------------
+    Every block stands alone, so forget the last one
+    ------------------------------------------------*/
+    mTable.fill( 0 );
+
+    if ( length > MatchLimit )
+    {
+      const uint8_t *const searchEnd = end - MatchLimit;
+      const uint8_t *const extendEnd = end - LastLiterals;
+      const uint8_t *ip              = src + 1;
+      size_t misses                  = 0;
+
+      while ( ip < searchEnd )
+      {
+        /*------------------------------------------------
+        Look up the last position with the same 4 bytes.
+        Incompressible input is skipped over ever faster.
+        ------------------------------------------------*/
+        const uint32_t sequence = read32( ip );
+        const uint32_t hash     = hashSequence<HashBits>( sequence );
+        const uint8_t *ref      = src + mTable[ hash ];
+
+        mTable[ hash ] = static_cast<uint32_t>( ip - src );
+
+        if ( ( ref >= ip ) || ( static_cast<size_t>( ip - ref ) > MaxOffset ) || ( read32( ref ) != sequence ) )
+        {
+          ip += 1 + ( misses++ >> SkipTrigger );
+          continue;
+        }
+
+        misses = 0;
+
+        /*------------------------------------------------
+        Grow the match in both directions
+        ------------------------------------------------*/
+        while ( ( ip > anchor ) && ( ref > src ) && ( ip[ -1 ] == ref[ -1 ] ) )
+        {
+          ip--;
+          ref--;
+        }
+
+        const uint8_t *const matchEnd = ip + MinMatch + countMatch( ip + MinMatch, ref + MinMatch, extendEnd );
+
+        op = putSequence( op, oend, anchor, static_cast<size_t>( ip - anchor ), static_cast<size_t>( ip - ref ),
+                          static_cast<size_t>( matchEnd - ip ) );
+        if ( !op )
+        {
+          return 0;
+        }
+
+        ip     = matchEnd;
+        anchor = ip;
+
+        /*------------------------------------------------
+        Index a position inside the match so that runs of
+        similar lines keep finding each other.
+        ------------------------------------------------*/
+        if ( ip < searchEnd )
+        {
+          mTable[ hashSequence<HashBits>( read32( ip - 2 ) ) ] = static_cast<uint32_t>( ip - 2 - src );
+        }
+      }
+    }
+
+    /*------------------------------------------------
+    Whatever is left goes out as literals
+    ------------------------------------------------*/
+    op = putSequence( op, oend, anchor, static_cast<size_t>( end - anchor ), 0, 0 );
+    return op ? static_cast<size_t>( op - dst ) : 0;
+  }
+
+  size_t BlockCompressor::encodeFrame( const void *const src, const size_t length, void *const dst, const size_t capacity )
+  {
+    if ( ( capacity < maxFrameSize( length ) ) || ( length >= FrameStoredFlag ) )
+    {
+      return 0;
+    }
+
+    uint8_t *const frame = static_cast<uint8_t *>( dst );
+    uint8_t *const body  = frame + FrameHeaderSize;
+
+    /*------------------------------------------------
+    Only keep the compressed form if it is smaller. The
+    output is bounded by the input size so a block that
+    grows is abandoned early and stored instead.
+    ------------------------------------------------*/
+    size_t stored = compress( static_cast<const uint8_t *>( src ), length, body, length );
+    uint32_t info = static_cast<uint32_t>( stored );
+
+    if ( !stored || ( stored >= length ) )
+    {
+      memcpy( body, src, length );
+      stored = length;
+      info   = static_cast<uint32_t>( length ) | FrameStoredFlag;
+    }
+
+    putLE32( frame, FrameMagic );
+    putLE32( frame + 4, static_cast<uint32_t>( length ) );
+    putLE32( frame + 8, info );
+
+    return FrameHeaderSize + stored;
+  }
+}    // namespace uLog::Compress
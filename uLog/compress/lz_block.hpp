@@ -0,0 +1,101 @@
+/********************************************************************************
+ *  File Name:
+ *    lz_block.hpp
+ *
+ *  Description:
+ *    Fast block compression for byte stream sinks. Blocks are encoded in the
+ *    LZ4 block format by a small greedy matcher with a fixed size hash table, so
+ *    memory use is bounded and known up front. Each block is wrapped in a frame
+ *    and compressed on its own, which means a truncated file still decodes up to
+ *    its last complete frame. Unpack with 'tools/ulog_decode.py unpack'.
+ *
+ *    Frame layout (little endian):
+ *      u32   FrameMagic
+ *      u32   Uncompressed length
+ *      u32   Stored length, with FrameStoredFlag set if the data is uncompressed
+ *      ...   Stored bytes
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_LZ_BLOCK_HPP
+#define MICRO_LOGGER_LZ_BLOCK_HPP
+
+/* C++ Includes */
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/* uLog Includes */
+#include <uLog/config.hpp>
+
+namespace uLog::Compress
+{
+  static constexpr uint32_t FrameMagic      = 0x315A4C55; /* "ULZ1" */
+  static constexpr uint32_t FrameStoredFlag = 0x80000000u;
+  static constexpr size_t FrameHeaderSize   = 3 * sizeof( uint32_t );
+
+  /**
+   *  Worst case size of a compressed block, before framing
+   *
+   *  @param[in]  length    Uncompressed length
+   *  @return size_t
+   */
+  constexpr size_t maxBlockSize( const size_t length )
+  {
+    return length + ( length / 255 ) + 16;
+  }
+
+  /**
+   *  Worst case size of a frame holding 'length' bytes of input. Since a frame
+   *  falls back to storing the input as is, this is only the header larger.
+   *
+   *  @param[in]  length    Uncompressed length
+   *  @return size_t
+   */
+  constexpr size_t maxFrameSize( const size_t length )
+  {
+    return FrameHeaderSize + length;
+  }
+
+  /**
+   *  Compressor state. Holds the match finder's hash table, so one instance
+   *  should not be shared between threads.
+   */
+  class BlockCompressor
+  {
+  public:
+    BlockCompressor();
+
+    /**
+     *  Compresses one block in the LZ4 block format
+     *
+     *  @param[in]  src       Input bytes
+     *  @param[in]  length    Number of input bytes, at most 2GiB
+     *  @param[out] dst       Output buffer
+     *  @param[in]  capacity  Size of the output buffer
+     *  @return size_t        Compressed size, or zero if it didn't fit
+     */
+    size_t compress( const uint8_t *const src, const size_t length, uint8_t *const dst, const size_t capacity );
+
+    /**
+     *  Compresses one block and wraps it in a frame. Input that doesn't shrink
+     *  is stored uncompressed.
+     *
+     *  @param[in]  src       Input bytes
+     *  @param[in]  length    Number of input bytes, at most 2GiB
+     *  @param[out] dst       Output buffer, at least maxFrameSize( length ) bytes
+     *  @param[in]  capacity  Size of the output buffer
+     *  @return size_t        Frame size, or zero if the output buffer is too small
+     */
+    size_t encodeFrame( const void *const src, const size_t length, void *const dst, const size_t capacity );
+
+  private:
+    static constexpr size_t HashBits = ULOG_COMPRESS_HASH_BITS;
+
+    std::array<uint32_t, ( 1u << HashBits )> mTable; /**< Last input offset seen for each hashed 4 byte sequence */
+  };
+}    // namespace uLog::Compress
+
+#endif /* !MICRO_LOGGER_LZ_BLOCK_HPP */
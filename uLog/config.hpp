@@ -25,4 +25,293 @@
  */
 #define ULOG_MAX_SNPRINTF_BUFFER_LENGTH ( 256u )
 
+/**
+ *  Set when the toolchain and OS support thread_local storage. Besides the
+ *  scratch buffers below, uLog uses it to notice a thread changing the sink
+ *  registry from inside a sink, which would otherwise wait on itself.
+ */
+#ifndef ULOG_HAS_THREAD_LOCAL
+#if defined( __linux__ ) || defined( __APPLE__ ) || defined( WIN32 ) || defined( WIN64 )
+#define ULOG_HAS_THREAD_LOCAL ( 1 )
+#else
+#define ULOG_HAS_THREAD_LOCAL ( 0 )
+#endif
+#endif
+
+/**
+ *  Selects where messages are formatted before being handed to the sinks. When
+ *  enabled, each thread formats into its own thread_local buffer. Otherwise, or
+ *  when a thread re-enters the logger while its buffer is busy, a buffer is
+ *  claimed from a small shared pool. Targets without TLS support should leave
+ *  this disabled.
+ */
+#ifndef ULOG_SCRATCH_USE_THREAD_LOCAL
+#define ULOG_SCRATCH_USE_THREAD_LOCAL ULOG_HAS_THREAD_LOCAL
+#endif
+
+/**
+ *  Number of shared scratch buffers, each ULOG_MAX_SNPRINTF_BUFFER_LENGTH bytes.
+ *  This bounds how many threads can format at the same time when thread_local
+ *  buffers aren't in use. Max of 32.
+ */
+#ifndef ULOG_SCRATCH_POOL_SIZE
+#define ULOG_SCRATCH_POOL_SIZE ( 4u )
+#endif
+
+/**
+ *  Numeric log levels for use in preprocessor expressions. These mirror the
+ *  values of uLog::Level.
+ */
+#define ULOG_LEVEL_TRACE ( 0 )
+#define ULOG_LEVEL_DEBUG ( 1 )
+#define ULOG_LEVEL_INFO  ( 2 )
+#define ULOG_LEVEL_WARN  ( 3 )
+#define ULOG_LEVEL_ERROR ( 4 )
+#define ULOG_LEVEL_FATAL ( 5 )
+#define ULOG_LEVEL_OFF   ( 6 )
+
+/**
+ *  Lowest level that the ULOG_* logging macros compile in. Call sites below this
+ *  level are removed entirely: their format strings don't reach the binary and
+ *  their arguments are never evaluated. Set to ULOG_LEVEL_OFF to strip all of them.
+ */
+#ifndef ULOG_COMPILE_TIME_MIN_LEVEL
+#define ULOG_COMPILE_TIME_MIN_LEVEL ULOG_LEVEL_TRACE
+#endif
+
+/**
+ *  Number of module IDs that can be given their own minimum log level. Each
+ *  costs two bytes of RAM.
+ */
+#ifndef ULOG_MAX_MODULES
+#define ULOG_MAX_MODULES ( 64u )
+#endif
+
+/**
+ *  Module ID used by the ULOG_* macros in a translation unit. Define it before
+ *  including uLog to tag everything a file logs with its subsystem.
+ */
+#ifndef ULOG_MODULE
+#define ULOG_MODULE ( 0 )
+#endif
+
+/**
+ *  Keeps sinks out of the heap. SinkHandle becomes a plain SinkInterface
+ *  pointer instead of a std::shared_ptr, and uLog::makeSink() constructs sinks
+ *  in statically sized storage, so neither registration nor logging allocates
+ *  or touches a reference count. The application owns each sink's lifetime.
+ */
+#ifndef ULOG_STATIC_SINK_STORAGE
+#define ULOG_STATIC_SINK_STORAGE ( 0 )
+#endif
+
+/**
+ *  Number of sinks of any one type uLog::makeSink() can hold when
+ *  ULOG_STATIC_SINK_STORAGE is set
+ */
+#ifndef ULOG_STATIC_SINKS_PER_TYPE
+#define ULOG_STATIC_SINKS_PER_TYPE ( 2u )
+#endif
+
+/**
+ *  Enables the asynchronous logging mode. Calls to uLog::log() copy the message
+ *  into a lock-free queue and return immediately. The application must create a
+ *  thread running uLog::asyncDrainThread() to deliver the queued messages to the
+ *  registered sinks.
+ */
+#ifndef ULOG_ENABLE_ASYNC_MODE
+#define ULOG_ENABLE_ASYNC_MODE ( 0 )
+#endif
+
+/**
+ *  Number of messages the asynchronous queue can hold before uLog::log() starts
+ *  reporting RESULT_FULL. Must be a power of two. Each entry is roughly the size
+ *  of ULOG_MAX_SNPRINTF_BUFFER_LENGTH.
+ */
+#ifndef ULOG_ASYNC_QUEUE_CAPACITY
+#define ULOG_ASYNC_QUEUE_CAPACITY ( 32u )
+#endif
+
+/**
+ *  How long the asynchronous drain thread sleeps when it finds the queue empty
+ */
+#ifndef ULOG_ASYNC_DRAIN_IDLE_MS
+#define ULOG_ASYNC_DRAIN_IDLE_MS ( 1u )
+#endif
+
+/**
+ *  Gives each producer thread a single-producer queue of its own, claimed the
+ *  first time the thread logs, instead of having every thread share one. Many
+ *  cores logging at once then no longer fight over the queue's cache lines.
+ *  The drain merges the queues back together by timestamp, so the sinks still
+ *  see records in time order. Only applies with ULOG_ENABLE_ASYNC_MODE, and
+ *  needs thread_local support.
+ */
+#ifndef ULOG_ASYNC_PER_THREAD_QUEUES
+#define ULOG_ASYNC_PER_THREAD_QUEUES ( 0 )
+#endif
+
+/**
+ *  Number of per thread queues. Threads that log while all of them are taken
+ *  use the shared queue, and are only merged in as their records arrive rather
+ *  than in strict time order. A queue is handed on when its thread exits.
+ */
+#ifndef ULOG_ASYNC_MAX_PRODUCERS
+#define ULOG_ASYNC_MAX_PRODUCERS ( 8u )
+#endif
+
+/**
+ *  Number of messages each per thread queue can hold. Must be a power of two.
+ */
+#ifndef ULOG_ASYNC_THREAD_QUEUE_CAPACITY
+#define ULOG_ASYNC_THREAD_QUEUE_CAPACITY ( 16u )
+#endif
+
+/**
+ *  Allows sinks to be registered with CFG_DELIVERY_QUEUED or
+ *  CFG_DELIVERY_DEDICATED. Messages for such a sink go into a queue of its own
+ *  and reach it from a delivery worker thread, so a slow sink only holds up
+ *  itself. The application runs the workers with uLog::deliveryWorkerThread().
+ */
+#ifndef ULOG_ENABLE_DELIVERY_WORKERS
+#define ULOG_ENABLE_DELIVERY_WORKERS ( 0 )
+#endif
+
+/**
+ *  Number of sinks that can have a delivery queue at the same time
+ */
+#ifndef ULOG_MAX_DELIVERY_QUEUES
+#define ULOG_MAX_DELIVERY_QUEUES ( 4u )
+#endif
+
+/**
+ *  Number of messages each sink's delivery queue can hold. Must be a power of
+ *  two. Each entry is roughly the size of ULOG_MAX_SNPRINTF_BUFFER_LENGTH, and
+ *  longer messages are dropped for queued sinks.
+ */
+#ifndef ULOG_DELIVERY_QUEUE_CAPACITY
+#define ULOG_DELIVERY_QUEUE_CAPACITY ( 32u )
+#endif
+
+/**
+ *  How long a delivery worker sleeps when it finds its queues empty
+ */
+#ifndef ULOG_DELIVERY_WORKER_IDLE_MS
+#define ULOG_DELIVERY_WORKER_IDLE_MS ( 1u )
+#endif
+
+/**
+ *  Source of the raw timestamp captured with every record. Define ULOG_TICK_READ
+ *  as an expression yielding a free running uint64_t counter (e.g. a cycle
+ *  counter) along with its rate in ULOG_TICK_HZ. Otherwise Linux hosts read
+ *  CLOCK_MONOTONIC_RAW in nanoseconds and everything else Chimera::micros().
+ */
+#if defined( ULOG_TICK_READ ) && !defined( ULOG_TICK_HZ )
+#error "ULOG_TICK_HZ must be defined along with ULOG_TICK_READ"
+#endif
+
+#ifndef ULOG_TICK_HZ
+#if defined( __linux__ )
+#define ULOG_TICK_HZ ( 1000000000ull )
+#else
+#define ULOG_TICK_HZ ( 1000000ull )
+#endif
+#endif
+
+/**
+ *  Enables coalescing of duplicate messages. Each sink remembers a hash of the
+ *  last message it was given; identical messages that follow within the window
+ *  are dropped and replaced by a single "last message repeated N times" line.
+ *  The summary goes out when a different message arrives, on uLog::flush(), or
+ *  once the window has expired. Expiry is noticed by the next message logged to
+ *  any sink, or by the async drain thread going idle, so a quiet system in sync
+ *  mode still needs a flush() to see the final count.
+ */
+#ifndef ULOG_ENABLE_COALESCING
+#define ULOG_ENABLE_COALESCING ( 0 )
+#endif
+
+/**
+ *  Longest time in milliseconds that repeats are folded into one summary
+ */
+#ifndef ULOG_COALESCE_WINDOW_MS
+#define ULOG_COALESCE_WINDOW_MS ( 1000u )
+#endif
+
+/**
+ *  Enables the self-metrics in uLog/metrics.hpp: per level message counts,
+ *  lock contention and a histogram of each sink's log() time. Costs a few
+ *  relaxed atomic adds per message and two tick reads per sink delivery.
+ */
+#ifndef ULOG_ENABLE_METRICS
+#define ULOG_ENABLE_METRICS ( 0 )
+#endif
+
+/**
+ *  Makes every LVL_FATAL message synchronous: the logging call returns only
+ *  after uLog::flush() has pushed it, and everything before it, out of the
+ *  queue and the sink buffers. Costs nothing for other levels. FATAL messages
+ *  from the async drain, a delivery worker, a sink or a thread holding an open
+ *  async Reservation don't flush, as flush() would wait on the calling thread.
+ *  A caller holding a lock one of the sinks needs would deadlock the same way;
+ *  log FATAL outside such locks, or use uLog::panicFlush() when the process is
+ *  about to die anyway.
+ */
+#ifndef ULOG_FLUSH_ON_FATAL
+#define ULOG_FLUSH_ON_FATAL ( 1 )
+#endif
+
+/**
+ *  Size of the alternate signal stack uLog::installCrashHandler() runs on, so
+ *  a stack overflow can still be reported
+ */
+#ifndef ULOG_CRASH_STACK_SIZE
+#define ULOG_CRASH_STACK_SIZE ( 64u * 1024u )
+#endif
+
+/**
+ *  Largest encoded record, in bytes, that ULOG_DEFERRED() will produce. Calls
+ *  whose arguments don't fit return RESULT_FAIL_MSG_TOO_LONG.
+ */
+#ifndef ULOG_DEFERRED_MAX_RECORD_LENGTH
+#define ULOG_DEFERRED_MAX_RECORD_LENGTH ( 64u )
+#endif
+
+/**
+ *  Default tuning for the POSIX file sink. See FileSink::Options.
+ */
+#ifndef ULOG_FILE_SINK_BUFFER_SIZE
+#define ULOG_FILE_SINK_BUFFER_SIZE ( 64u * 1024u )
+#endif
+
+#ifndef ULOG_FILE_SINK_BUFFER_COUNT
+#define ULOG_FILE_SINK_BUFFER_COUNT ( 8u )
+#endif
+
+#ifndef ULOG_FILE_SINK_FLUSH_INTERVAL_MS
+#define ULOG_FILE_SINK_FLUSH_INTERVAL_MS ( 100u )
+#endif
+
+/**
+ *  Size of the match finder hash table used by the block compressor, as a
+ *  power of two. Each compressor holds 4 << ULOG_COMPRESS_HASH_BITS bytes.
+ */
+#ifndef ULOG_COMPRESS_HASH_BITS
+#define ULOG_COMPRESS_HASH_BITS ( 12u )
+#endif
+
+/**
+ *  Size of the output buffer owned by each ConsoleSink
+ */
+#ifndef ULOG_CONSOLE_SINK_BUFFER_SIZE
+#define ULOG_CONSOLE_SINK_BUFFER_SIZE ( 4096u )
+#endif
+
+/**
+ *  Default size in bytes of the record area of a MappedRingSink file
+ */
+#ifndef ULOG_MAPPED_RING_DEFAULT_CAPACITY
+#define ULOG_MAPPED_RING_DEFAULT_CAPACITY ( 1024u * 1024u )
+#endif
+
 #endif  /* MICRO_LOGGER_CONFIGURATION_HPP */
\ No newline at end of file
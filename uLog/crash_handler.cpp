@@ -0,0 +1,152 @@
+/********************************************************************************
+ *  File Name:
+ *    crash_handler.cpp
+ *
+ *  Description:
+ *    Implementation of the POSIX crash handler
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* uLog Includes */
+#include <uLog/crash_handler.hpp>
+
+#if defined( MICRO_LOGGER_HAS_CRASH_HANDLER ) && ( MICRO_LOGGER_HAS_CRASH_HANDLER == 1 )
+
+/* C++ Includes */
+#include <array>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+
+/* POSIX Includes */
+#include <signal.h>
+
+/* uLog Includes */
+#include <uLog/config.hpp>
+#include <uLog/ulog.hpp>
+
+namespace uLog
+{
+  static constexpr std::array<int, 5> CrashSignals = { SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT };
+
+  static bool crashHandlerInstalled = false;
+  static std::array<struct sigaction, CrashSignals.size()> previousActions;
+  alignas( 16 ) static uint8_t crashStack[ ULOG_CRASH_STACK_SIZE ];
+
+  /**
+   *  Reports the signal, then lets the previous handler (usually the default
+   *  one, which kills the process) deal with it
+   *
+   *  @param[in]  signal    The signal that fired
+   *  @return void
+   */
+  static void crashHandler( int signal )
+  {
+    /*------------------------------------------------
+    snprintf isn't async-signal-safe, so build the note
+    by hand
+    ------------------------------------------------*/
+    static constexpr char Prefix[] = "uLog: fatal signal ";
+    char note[ sizeof( Prefix ) + 12 ];
+    size_t length = sizeof( Prefix ) - 1;
+
+    for ( size_t i = 0; i < length; i++ )
+    {
+      note[ i ] = Prefix[ i ];
+    }
+
+    char digits[ 10 ];
+    size_t count   = 0;
+    unsigned value = static_cast<unsigned>( signal );
+
+    do
+    {
+      digits[ count++ ] = static_cast<char>( '0' + ( value % 10 ) );
+      value /= 10;
+    } while ( value && ( count < sizeof( digits ) ) );
+
+    while ( count )
+    {
+      note[ length++ ] = digits[ --count ];
+    }
+
+    note[ length++ ] = '\n';
+    panicFlush( note, length );
+
+    /*------------------------------------------------
+    Re-raise under the old action. The signal is blocked
+    while this handler runs, so it lands on return.
+    ------------------------------------------------*/
+    for ( size_t i = 0; i < CrashSignals.size(); i++ )
+    {
+      if ( CrashSignals[ i ] == signal )
+      {
+        sigaction( signal, &previousActions[ i ], nullptr );
+        break;
+      }
+    }
+
+    raise( signal );
+  }
+
+  Result installCrashHandler()
+  {
+    if ( crashHandlerInstalled )
+    {
+      return Result::RESULT_SUCCESS;
+    }
+
+    /*------------------------------------------------
+    A stack overflow leaves nothing to run the handler
+    on, so give it a stack of its own
+    ------------------------------------------------*/
+    stack_t stack;
+    stack.ss_sp    = crashStack;
+    stack.ss_size  = sizeof( crashStack );
+    stack.ss_flags = 0;
+
+    if ( sigaltstack( &stack, nullptr ) != 0 )
+    {
+      return Result::RESULT_FAIL;
+    }
+
+    struct sigaction action = {};
+    action.sa_handler       = crashHandler;
+    action.sa_flags         = SA_ONSTACK;
+    sigemptyset( &action.sa_mask );
+
+    for ( size_t i = 0; i < CrashSignals.size(); i++ )
+    {
+      if ( sigaction( CrashSignals[ i ], &action, &previousActions[ i ] ) != 0 )
+      {
+        while ( i-- )
+        {
+          sigaction( CrashSignals[ i ], &previousActions[ i ], nullptr );
+        }
+
+        return Result::RESULT_FAIL;
+      }
+    }
+
+    crashHandlerInstalled = true;
+    return Result::RESULT_SUCCESS;
+  }
+
+  void removeCrashHandler()
+  {
+    if ( !crashHandlerInstalled )
+    {
+      return;
+    }
+
+    for ( size_t i = 0; i < CrashSignals.size(); i++ )
+    {
+      sigaction( CrashSignals[ i ], &previousActions[ i ], nullptr );
+    }
+
+    crashHandlerInstalled = false;
+  }
+}    // namespace uLog
+
+#endif /* MICRO_LOGGER_HAS_CRASH_HANDLER */
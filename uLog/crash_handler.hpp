@@ -0,0 +1,46 @@
+/********************************************************************************
+ *  File Name:
+ *    crash_handler.hpp
+ *
+ *  Description:
+ *    Optional POSIX signal handler that gets buffered log output onto disk
+ *    when the process crashes. On SIGSEGV, SIGBUS, SIGILL, SIGFPE or SIGABRT
+ *    it calls uLog::panicFlush() with a one line note naming the signal, then
+ *    hands the signal to whatever handler was installed before it.
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_CRASH_HANDLER_HPP
+#define MICRO_LOGGER_CRASH_HANDLER_HPP
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#define MICRO_LOGGER_HAS_CRASH_HANDLER ( 1 )
+
+/* uLog Includes */
+#include <uLog/types.hpp>
+
+namespace uLog
+{
+  /**
+   *  Installs the crash handler. Call once after the sinks are registered;
+   *  calling again does nothing.
+   *
+   *  @note The alternate signal stack is only set up for the calling thread,
+   *        so a stack overflow is reported only if it happens there.
+   *
+   *  @return Result        RESULT_FAIL if a handler couldn't be installed
+   */
+  Result installCrashHandler();
+
+  /**
+   *  Puts back the handlers that were in place before installCrashHandler()
+   *
+   *  @return void
+   */
+  void removeCrashHandler();
+}    // namespace uLog
+
+#endif /* __unix__ || __APPLE__ */
+#endif /* !MICRO_LOGGER_CRASH_HANDLER_HPP */
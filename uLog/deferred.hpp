@@ -0,0 +1,278 @@
+/********************************************************************************
+ *  File Name:
+ *    deferred.hpp
+ *
+ *  Description:
+ *    Deferred formatting support. Instead of running snprintf on the device, a
+ *    call site logs a compile-time hash of its format string along with the raw
+ *    argument bytes. The text is rebuilt off target by tools/ulog_decode.py using
+ *    a format string table extracted from the sources at build time.
+ *
+ *    Record layout (little endian):
+ *      u32   Format string ID (FNV-1a hash of the format string)
+ *      u8    Log level
+ *      u32   Timestamp in milliseconds
+ *      u8    Number of argument bytes that follow
+ *      ...   Arguments, each a one byte ArgType tag followed by its value
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_DEFERRED_HPP
+#define MICRO_LOGGER_DEFERRED_HPP
+
+/* C++ Includes */
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+/* Chimera Includes */
+#include <Chimera/common>
+
+/* uLog Includes */
+#include <uLog/config.hpp>
+#include <uLog/types.hpp>
+#include <uLog/ulog.hpp>
+
+/**
+ *  Logs a message with deferred formatting. The format string must be a literal
+ *  so that it can be hashed at compile time and found by the extraction tool.
+ *  Only the hash makes it into the binary. Call sites below
+ *  ULOG_COMPILE_TIME_MIN_LEVEL are compiled out. The output only reaches sinks
+ *  set to RecordFormat::BINARY; text sinks skip it, as they can't frame it.
+ *
+ *  Example:  ULOG_DEFERRED( uLog::Level::LVL_INFO, "ADC %d read %u mV", channel, mv );
+ */
+#define ULOG_DEFERRED( lvl, fmt, ... )                                                                  \
+  do                                                                                                    \
+  {                                                                                                     \
+    if constexpr ( ::uLog::isCompiledIn( lvl ) )                                                        \
+    {                                                                                                   \
+      ::uLog::Deferred::log<::uLog::Deferred::formatId( fmt )>( ULOG_THIS_MODULE, lvl, ##__VA_ARGS__ ); \
+    }                                                                                                   \
+  } while ( 0 )
+
+namespace uLog::Deferred
+{
+  /**
+   *  Tags describing how each argument was encoded. Must stay in sync with the
+   *  decoder in tools/ulog_decode.py.
+   */
+  enum class ArgType : uint8_t
+  {
+    ARG_SINT,   /**< Zig-zag encoded signed integer, LEB128 varint */
+    ARG_UINT,   /**< Unsigned integer, LEB128 varint */
+    ARG_CHAR,   /**< Single byte character */
+    ARG_F32,    /**< IEEE-754 single precision */
+    ARG_F64,    /**< IEEE-754 double precision */
+    ARG_STRING, /**< u8 length followed by the characters, no terminator */
+    ARG_POINTER /**< Pointer value as an unsigned LEB128 varint */
+  };
+
+  static constexpr size_t HeaderSize = 10;
+
+  /**
+   *  Computes the 32-bit FNV-1a hash of a format string. Evaluated at compile
+   *  time by ULOG_DEFERRED() so the string itself never reaches the binary.
+   *
+   *  @param[in]  str       Null terminated format string
+   *  @return uint32_t
+   */
+  constexpr uint32_t formatId( const char *str )
+  {
+    uint32_t hash = 2166136261u;
+
+    while ( *str )
+    {
+      hash ^= static_cast<uint8_t>( *str++ );
+      hash *= 16777619u;
+    }
+
+    return hash;
+  }
+
+  /**
+   *  Bounded byte writer for building a single record
+   */
+  class RecordWriter
+  {
+  public:
+    RecordWriter( uint8_t *const buffer, const size_t size ) : mBuffer( buffer ), mSize( size ), mOffset( 0 ), mOverflow( false )
+    {
+    }
+
+    void put( const uint8_t byte )
+    {
+      if ( mOffset < mSize )
+      {
+        mBuffer[ mOffset++ ] = byte;
+      }
+      else
+      {
+        mOverflow = true;
+      }
+    }
+
+    void put( const void *const data, const size_t length )
+    {
+      if ( ( mSize - mOffset ) >= length )
+      {
+        memcpy( mBuffer + mOffset, data, length );
+        mOffset += length;
+      }
+      else
+      {
+        mOverflow = true;
+      }
+    }
+
+    void putLE32( const uint32_t value )
+    {
+      for ( size_t i = 0; i < sizeof( value ); i++ )
+      {
+        put( static_cast<uint8_t>( value >> ( 8u * i ) ) );
+      }
+    }
+
+    void putVarint( uint64_t value )
+    {
+      do
+      {
+        uint8_t byte = value & 0x7Fu;
+        value >>= 7u;
+        put( value ? ( byte | 0x80u ) : byte );
+      } while ( value );
+    }
+
+    size_t size() const
+    {
+      return mOffset;
+    }
+
+    bool overflowed() const
+    {
+      return mOverflow;
+    }
+
+  private:
+    uint8_t *const mBuffer;
+    const size_t mSize;
+    size_t mOffset;
+    bool mOverflow;
+  };
+
+  /*-------------------------------------------------------------------------------
+  Argument encoders. The overload set doubles as the type check: anything that
+  can't be represented offline fails to compile.
+  -------------------------------------------------------------------------------*/
+  template<typename T>
+  void encode( RecordWriter &writer, const T &arg )
+  {
+    if constexpr ( std::is_same_v<T, char> )
+    {
+      writer.put( static_cast<uint8_t>( ArgType::ARG_CHAR ) );
+      writer.put( static_cast<uint8_t>( arg ) );
+    }
+    else if constexpr ( std::is_same_v<T, bool> || ( std::is_integral_v<T> && std::is_unsigned_v<T> ) )
+    {
+      writer.put( static_cast<uint8_t>( ArgType::ARG_UINT ) );
+      writer.putVarint( static_cast<uint64_t>( arg ) );
+    }
+    else if constexpr ( std::is_integral_v<T> || std::is_enum_v<T> )
+    {
+      const int64_t value = static_cast<int64_t>( arg );
+      writer.put( static_cast<uint8_t>( ArgType::ARG_SINT ) );
+      writer.putVarint( ( static_cast<uint64_t>( value ) << 1u ) ^ static_cast<uint64_t>( value >> 63 ) );
+    }
+    else if constexpr ( std::is_same_v<T, float> )
+    {
+      writer.put( static_cast<uint8_t>( ArgType::ARG_F32 ) );
+      writer.put( &arg, sizeof( arg ) );
+    }
+    else if constexpr ( std::is_floating_point_v<T> )
+    {
+      const double value = static_cast<double>( arg );
+      writer.put( static_cast<uint8_t>( ArgType::ARG_F64 ) );
+      writer.put( &value, sizeof( value ) );
+    }
+    else if constexpr ( std::is_convertible_v<T, std::string_view> )
+    {
+      /*------------------------------------------------
+      A null C string can't become a string_view, so it
+      goes out as the text the eager formatter prints
+      ------------------------------------------------*/
+      std::string_view str = "(null)";
+
+      if constexpr ( std::is_pointer_v<T> )
+      {
+        if ( arg )
+        {
+          str = arg;
+        }
+      }
+      else if constexpr ( !std::is_null_pointer_v<T> )
+      {
+        str = arg;
+      }
+
+      const size_t length = str.size() < 0xFFu ? str.size() : 0xFFu;
+
+      writer.put( static_cast<uint8_t>( ArgType::ARG_STRING ) );
+      writer.put( static_cast<uint8_t>( length ) );
+      writer.put( str.data(), length );
+    }
+    else if constexpr ( std::is_pointer_v<T> )
+    {
+      writer.put( static_cast<uint8_t>( ArgType::ARG_POINTER ) );
+      writer.putVarint( reinterpret_cast<uintptr_t>( arg ) );
+    }
+    else
+    {
+      static_assert( !sizeof( T ), "Argument type cannot be logged with deferred formatting" );
+    }
+  }
+
+  /**
+   *  Encodes a deferred record and hands it to every registered sink. Use the
+   *  ULOG_DEFERRED() macro rather than calling this directly.
+   *
+   *  @param[in]  module    The module the message came from
+   *  @param[in]  lvl       The severity level of the message
+   *  @param[in]  args      Arguments referenced by the format string
+   *  @return Result
+   */
+  template<uint32_t ID, typename... Args>
+  Result log( const ModuleId module, const Level lvl, const Args &... args )
+  {
+    if ( !isLevelEnabled( module, lvl ) )
+    {
+      return Result::RESULT_FAIL;
+    }
+
+    std::array<uint8_t, ULOG_DEFERRED_MAX_RECORD_LENGTH> record;
+    RecordWriter writer( record.data(), record.size() );
+
+    /*------------------------------------------------
+    Header. The argument length is patched in below.
+    ------------------------------------------------*/
+    writer.putLE32( ID );
+    writer.put( static_cast<uint8_t>( lvl ) );
+    writer.putLE32( static_cast<uint32_t>( Chimera::millis() ) );
+    writer.put( 0 );
+
+    ( encode( writer, args ), ... );
+
+    if ( writer.overflowed() || ( ( writer.size() - HeaderSize ) > 0xFFu ) )
+    {
+      return Result::RESULT_FAIL_MSG_TOO_LONG;
+    }
+
+    record[ HeaderSize - 1 ] = static_cast<uint8_t>( writer.size() - HeaderSize );
+    return ::uLog::logRecord( RecordType::DEFERRED, module, lvl, record.data(), writer.size() );
+  }
+}    // namespace uLog::Deferred
+
+#endif /* !MICRO_LOGGER_DEFERRED_HPP */
@@ -0,0 +1,377 @@
+/********************************************************************************
+ *  File Name:
+ *    format.cpp
+ *
+ *  Description:
+ *    Value writers for the compile time checked formatter
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* C++ Includes */
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+/* uLog Includes */
+#include <uLog/format.hpp>
+
+namespace uLog::Format
+{
+  static constexpr char LowerDigits[] = "0123456789abcdef";
+  static constexpr char UpperDigits[] = "0123456789ABCDEF";
+
+  /*-------------------------------------------------
+  FIXED conversions are done in integer arithmetic up
+  to this precision and magnitude, and by snprintf past
+  them
+  -------------------------------------------------*/
+  static constexpr uint16_t FixedMaxPrecision = 9;
+  static constexpr double FixedMaxMagnitude   = 1e18;
+
+  /*-------------------------------------------------
+  Scaling the fraction by up to 1e9 is off by at most
+  about 1.2e-7, so products nearer a tie than this are
+  rounded by snprintf instead
+  -------------------------------------------------*/
+  static constexpr double FixedTieMargin = 1e-6;
+  static constexpr std::array<uint64_t, FixedMaxPrecision + 1> PowersOfTen = { 1ull,         10ull,         100ull,     1000ull,
+                                                                               10000ull,     100000ull,     1000000ull, 10000000ull,
+                                                                               100000000ull, 1000000000ull };
+
+  /**
+   *  Writes the digits of a value into the end of a buffer. The base is a
+   *  template parameter so the divisions become multiplies and shifts.
+   *
+   *  @param[in]  value     Value to convert
+   *  @param[in]  upper     Upper case hex digits
+   *  @param[out] end       One past the last byte of the buffer
+   *  @return size_t        Number of digits written, ending just before 'end'
+   */
+  template<unsigned BASE>
+  static size_t toDigits( uint64_t value, const bool upper, char *const end )
+  {
+    const char *const digits = upper ? UpperDigits : LowerDigits;
+    char *cursor             = end;
+
+    do
+    {
+      *--cursor = digits[ value % BASE ];
+      value /= BASE;
+    } while ( value );
+
+    return static_cast<size_t>( end - cursor );
+  }
+
+  static size_t toDigits( const uint64_t value, const unsigned base, const bool upper, char *const end )
+  {
+    switch ( base )
+    {
+      case 8:
+        return toDigits<8>( value, upper, end );
+
+      case 16:
+        return toDigits<16>( value, upper, end );
+
+      default:
+        return toDigits<10>( value, upper, end );
+    }
+  }
+
+  void Writer::padded( const char *const prefix, const size_t prefixLength, const char *const body, const size_t bodyLength,
+                       const size_t zeros, const Spec &spec )
+  {
+    const size_t length = prefixLength + zeros + bodyLength;
+
+    /*------------------------------------------------
+    Most conversions have no width to pad out to
+    ------------------------------------------------*/
+    if ( ( spec.width <= length ) && !zeros )
+    {
+      if ( prefixLength )
+      {
+        put( prefix, prefixLength );
+      }
+
+      put( body, bodyLength );
+      return;
+    }
+
+    const size_t padding = ( spec.width > length ) ? ( spec.width - length ) : 0;
+    const bool left      = spec.flags & FLAG_LEFT;
+    const bool zeroPad   = !left && ( spec.flags & FLAG_ZERO );
+
+    if ( !left && !zeroPad )
+    {
+      fill( ' ', padding );
+    }
+
+    put( prefix, prefixLength );
+    fill( '0', zeros + ( zeroPad ? padding : 0 ) );
+    put( body, bodyLength );
+
+    if ( left )
+    {
+      fill( ' ', padding );
+    }
+  }
+
+  void Writer::integer( const uint64_t magnitude, const bool negative, const Spec &spec )
+  {
+    char digits[ 24 ];
+    char prefix[ 2 ];
+    size_t prefixLength = 0;
+
+    const unsigned base = ( spec.conversion == Conversion::OCTAL ) ? 8 :
+                          ( ( spec.conversion == Conversion::HEX_LOWER ) || ( spec.conversion == Conversion::HEX_UPPER ) ) ? 16 : 10;
+    const bool upper    = ( spec.conversion == Conversion::HEX_UPPER );
+
+    /*------------------------------------------------
+    An explicit zero precision prints nothing for zero
+    ------------------------------------------------*/
+    size_t count = 0;
+    if ( magnitude || !( spec.flags & FLAG_PRECISION ) || spec.precision )
+    {
+      count = toDigits( magnitude, base, upper, digits + sizeof( digits ) );
+    }
+
+    if ( negative )
+    {
+      prefix[ prefixLength++ ] = '-';
+    }
+    else if ( spec.conversion == Conversion::SIGNED )
+    {
+      if ( spec.flags & FLAG_PLUS )
+      {
+        prefix[ prefixLength++ ] = '+';
+      }
+      else if ( spec.flags & FLAG_SPACE )
+      {
+        prefix[ prefixLength++ ] = ' ';
+      }
+    }
+    else if ( ( spec.flags & FLAG_ALT ) && ( base == 16 ) && magnitude )
+    {
+      prefix[ prefixLength++ ] = '0';
+      prefix[ prefixLength++ ] = upper ? 'X' : 'x';
+    }
+
+    /*------------------------------------------------
+    Minimum digits: the precision, or a leading zero for
+    alternate form octal
+    ------------------------------------------------*/
+    size_t zeros = ( spec.flags & FLAG_PRECISION ) && ( spec.precision > count ) ? ( spec.precision - count ) : 0;
+
+    if ( ( spec.flags & FLAG_ALT ) && ( base == 8 ) && !zeros && ( !count || ( digits[ sizeof( digits ) - count ] != '0' ) ) )
+    {
+      zeros = 1;
+    }
+
+    /*------------------------------------------------
+    A precision turns off zero padding to the width
+    ------------------------------------------------*/
+    Spec layout = spec;
+    if ( spec.flags & FLAG_PRECISION )
+    {
+      layout.flags &= static_cast<uint8_t>( ~FLAG_ZERO );
+    }
+
+    padded( prefix, prefixLength, digits + sizeof( digits ) - count, count, zeros, layout );
+  }
+
+  void Writer::pointer( const uintptr_t address, const Spec &spec )
+  {
+    if ( !address )
+    {
+      string( "(nil)", 5, spec );
+      return;
+    }
+
+    char digits[ 2 * sizeof( uintptr_t ) ];
+    const size_t count = toDigits<16>( address, false, digits + sizeof( digits ) );
+
+    Spec layout = spec;
+    layout.flags &= static_cast<uint8_t>( ~FLAG_ZERO );
+    padded( "0x", 2, digits + sizeof( digits ) - count, count, 0, layout );
+  }
+
+  void Writer::character( const char c, const Spec &spec )
+  {
+    Spec layout = spec;
+    layout.flags &= static_cast<uint8_t>( ~FLAG_ZERO );
+    padded( "", 0, &c, 1, 0, layout );
+  }
+
+  void Writer::string( const char *const str, const Spec &spec )
+  {
+    if ( !str )
+    {
+      string( "(null)", 6, spec );
+      return;
+    }
+
+    /*------------------------------------------------
+    Plain %s copies in the same pass that finds the end
+    ------------------------------------------------*/
+    if ( !spec.width && !( spec.flags & FLAG_PRECISION ) )
+    {
+      char *const out = mBuffer;
+      size_t length   = mLength;
+
+      for ( const char *c = str; *c && ( length < mCapacity ); c++ )
+      {
+        out[ length++ ] = *c;
+      }
+
+      mLength = length;
+      return;
+    }
+
+    /*------------------------------------------------
+    No need to look further than the precision, or than
+    the output can still hold past any padding
+    ------------------------------------------------*/
+    const size_t room  = ( mCapacity - mLength ) + spec.width;
+    const size_t limit = ( spec.flags & FLAG_PRECISION ) ? spec.precision : room;
+
+    string( str, strnlen( str, limit ), spec );
+  }
+
+  void Writer::string( const char *const data, const size_t length, const Spec &spec )
+  {
+    const size_t shown = ( spec.flags & FLAG_PRECISION ) ? std::min<size_t>( length, spec.precision ) : length;
+
+    Spec layout = spec;
+    layout.flags &= static_cast<uint8_t>( ~FLAG_ZERO );
+    padded( "", 0, data, shown, 0, layout );
+  }
+
+  void Writer::fixed( const double value, const Spec &spec, const char *const specText )
+  {
+    const uint16_t precision = ( spec.flags & FLAG_PRECISION ) ? spec.precision : 6;
+
+    if ( !std::isfinite( value ) || ( precision > FixedMaxPrecision ) || ( std::fabs( value ) >= FixedMaxMagnitude ) )
+    {
+      floating( value, spec, specText );
+      return;
+    }
+
+    /*------------------------------------------------
+    Split into whole and fractional parts, rounding the
+    last digit shown to nearest like printf does
+    ------------------------------------------------*/
+    const bool negative  = std::signbit( value );
+    const double v       = std::fabs( value );
+    const uint64_t scale = PowersOfTen[ precision ];
+    uint64_t whole       = static_cast<uint64_t>( precision ? std::trunc( v ) : std::nearbyint( v ) );
+    uint64_t fraction    = 0;
+
+    if ( precision )
+    {
+      /*----------------------------------------------
+      The subtraction is exact but the scaling is not,
+      so a product this close to a tie may round the
+      wrong way. Let snprintf decide those from the
+      exact binary value.
+      ----------------------------------------------*/
+      const double scaled = ( v - static_cast<double>( whole ) ) * static_cast<double>( scale );
+
+      if ( std::fabs( ( scaled - std::floor( scaled ) ) - 0.5 ) < FixedTieMargin )
+      {
+        floating( value, spec, specText );
+        return;
+      }
+
+      fraction = static_cast<uint64_t>( std::nearbyint( scaled ) );
+    }
+
+    if ( fraction >= scale )
+    {
+      whole++;
+      fraction -= scale;
+    }
+
+    /*------------------------------------------------
+    whole[.fraction], the fraction zero filled on the left
+    ------------------------------------------------*/
+    char body[ 40 ];
+    char *const end = body + sizeof( body );
+    char *cursor    = end;
+
+    if ( precision )
+    {
+      cursor -= toDigits<10>( fraction, false, cursor );
+      while ( ( end - cursor ) < precision )
+      {
+        *--cursor = '0';
+      }
+    }
+
+    if ( precision || ( spec.flags & FLAG_ALT ) )
+    {
+      *--cursor = '.';
+    }
+
+    cursor -= toDigits<10>( whole, false, cursor );
+
+    char sign         = 0;
+    size_t signLength = 0;
+
+    if ( negative )
+    {
+      sign       = '-';
+      signLength = 1;
+    }
+    else if ( spec.flags & FLAG_PLUS )
+    {
+      sign       = '+';
+      signLength = 1;
+    }
+    else if ( spec.flags & FLAG_SPACE )
+    {
+      sign       = ' ';
+      signLength = 1;
+    }
+
+    padded( &sign, signLength, cursor, static_cast<size_t>( end - cursor ), 0, spec );
+  }
+
+  void Writer::floating( const double value, const Spec &spec, const char *const specText )
+  {
+    /*------------------------------------------------
+    Rebuild the conversion without length modifiers, as
+    the value is always passed as a double
+    ------------------------------------------------*/
+    char conversion[ 24 ];
+    size_t length = 0;
+
+    for ( size_t i = 0; ( i < spec.specLength ) && ( length < ( sizeof( conversion ) - 1 ) ); i++ )
+    {
+      const char c = specText[ i ];
+
+      if ( !strchr( "hljztL", c ) )
+      {
+        conversion[ length++ ] = c;
+      }
+    }
+
+    conversion[ length ] = '\0';
+
+    /*------------------------------------------------
+    Write in place; snprintf terminates inside the byte
+    the Writer keeps spare
+    ------------------------------------------------*/
+    const size_t room = mCapacity - mLength;
+    if ( !room )
+    {
+      return;
+    }
+
+    const int written = snprintf( mBuffer + mLength, room + 1, conversion, value );
+
+    if ( written > 0 )
+    {
+      mLength += std::min<size_t>( written, room );
+    }
+  }
+}    // namespace uLog::Format
@@ -0,0 +1,558 @@
+/********************************************************************************
+ *  File Name:
+ *    format.hpp
+ *
+ *  Description:
+ *    Compile time checked replacement for snprintf. A format string wrapped in
+ *    ULOG_FMT() is parsed while compiling; each argument is then written by a
+ *    writer picked for its conversion, and a type that doesn't suit its
+ *    conversion, or a wrong argument count, fails the build:
+ *
+ *      char text[ 64 ];
+ *      const size_t length = uLog::Format::format( text, sizeof( text ), ULOG_FMT( "ch %u: %.2f V" ), ch, volts );
+ *
+ *    Supports the flags "-0+ #", a numeric width and precision, and the
+ *    conversions d i u o x X c s p f F e E g G a A. Length modifiers (hh, l,
+ *    z, ...) are accepted and ignored: the argument's own type decides how
+ *    wide it is. e, g and a are handed to snprintf one value at a time.
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_FORMAT_HPP
+#define MICRO_LOGGER_FORMAT_HPP
+
+/* C++ Includes */
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/**
+ *  Turns a string literal into a format string that is parsed and checked at
+ *  compile time. The ULOG_* formatting macros apply it for you.
+ *
+ *  @param[in]  str       Format string literal
+ */
+#define ULOG_FMT( str )                              \
+  ( [] {                                             \
+    struct UlogFormat_ : ::uLog::Format::Literal     \
+    {                                                \
+      static constexpr std::string_view view()       \
+      {                                              \
+        return str;                                  \
+      }                                              \
+    };                                               \
+    return UlogFormat_{};                            \
+  }() )
+
+namespace uLog::Format
+{
+  /**
+   *  Base of the types ULOG_FMT() creates, each carrying one format string
+   */
+  struct Literal
+  {
+  };
+
+  template<typename T>
+  static constexpr bool isLiteral = std::is_base_of_v<Literal, T>;
+
+  enum class Conversion : uint8_t
+  {
+    SIGNED,    /**< d i */
+    UNSIGNED,  /**< u */
+    OCTAL,     /**< o */
+    HEX_LOWER, /**< x */
+    HEX_UPPER, /**< X */
+    CHARACTER, /**< c */
+    STRING,    /**< s */
+    POINTER,   /**< p */
+    FIXED,     /**< f F */
+    FLOAT      /**< e E g G a A, via snprintf */
+  };
+
+  enum Flags : uint8_t
+  {
+    FLAG_LEFT      = ( 1u << 0 ), /**< '-' */
+    FLAG_ZERO      = ( 1u << 1 ), /**< '0' */
+    FLAG_PLUS      = ( 1u << 2 ), /**< '+' */
+    FLAG_SPACE     = ( 1u << 3 ), /**< ' ' */
+    FLAG_ALT       = ( 1u << 4 ), /**< '#' */
+    FLAG_PRECISION = ( 1u << 5 ), /**< A precision was given */
+    FLAG_ESCAPED   = ( 1u << 6 )  /**< The text ahead of the conversion contains "%%" */
+  };
+
+  /**
+   *  One conversion and the literal text leading up to it
+   */
+  struct Spec
+  {
+    size_t textBegin;
+    size_t textLength;
+    size_t specBegin;  /**< From the '%' through the conversion letter */
+    size_t specLength;
+    Conversion conversion;
+    uint8_t flags;
+    uint16_t width;
+    uint16_t precision;
+  };
+
+  /**
+   *  A parsed format string: one Spec per argument, then one holding only the
+   *  trailing text
+   */
+  template<size_t N>
+  struct Parsed
+  {
+    bool valid;
+    size_t count;
+    std::array<Spec, N + 1> specs;
+  };
+
+  /**
+   *  Upper bound on the conversions in a format string
+   *
+   *  @param[in]  str       Format string
+   *  @return size_t
+   */
+  constexpr size_t maxConversions( const std::string_view str )
+  {
+    size_t count = 0;
+
+    for ( const char c : str )
+    {
+      count += ( c == '%' ) ? 1 : 0;
+    }
+
+    return count;
+  }
+
+  /**
+   *  Splits a format string into conversions
+   *
+   *  @param[in]  str       Format string
+   *  @return Parsed<N>     valid is false for anything unsupported
+   */
+  template<size_t N>
+  constexpr Parsed<N> parse( const std::string_view str )
+  {
+    Parsed<N> out{};
+    out.valid        = true;
+    size_t i         = 0;
+    size_t textBegin = 0;
+    bool escaped     = false;
+
+    while ( i < str.size() )
+    {
+      if ( str[ i ] != '%' )
+      {
+        i++;
+        continue;
+      }
+      else if ( ( ( i + 1 ) < str.size() ) && ( str[ i + 1 ] == '%' ) )
+      {
+        escaped = true;
+        i += 2;
+        continue;
+      }
+
+      Spec spec{};
+      spec.textBegin  = textBegin;
+      spec.textLength = i - textBegin;
+      spec.specBegin  = i++;
+      spec.flags      = escaped ? FLAG_ESCAPED : 0;
+
+      /*------------------------------------------------
+      %[flags][width][.precision][length]conversion
+      ------------------------------------------------*/
+      for ( bool isFlag = true; isFlag && ( i < str.size() ); )
+      {
+        const size_t flag = std::string_view( "-0+ #" ).find( str[ i ] );
+        isFlag            = ( flag != std::string_view::npos );
+
+        if ( isFlag )
+        {
+          spec.flags |= static_cast<uint8_t>( 1u << flag );
+          i++;
+        }
+      }
+
+      for ( ; ( i < str.size() ) && ( str[ i ] >= '0' ) && ( str[ i ] <= '9' ); i++ )
+      {
+        spec.width = static_cast<uint16_t>( spec.width * 10 + ( str[ i ] - '0' ) );
+      }
+
+      if ( ( i < str.size() ) && ( str[ i ] == '.' ) )
+      {
+        spec.flags |= FLAG_PRECISION;
+
+        for ( i++; ( i < str.size() ) && ( str[ i ] >= '0' ) && ( str[ i ] <= '9' ); i++ )
+        {
+          spec.precision = static_cast<uint16_t>( spec.precision * 10 + ( str[ i ] - '0' ) );
+        }
+      }
+
+      while ( ( i < str.size() ) && ( std::string_view( "hljztL" ).find( str[ i ] ) != std::string_view::npos ) )
+      {
+        i++;
+      }
+
+      if ( i >= str.size() )
+      {
+        out.valid = false;
+        return out;
+      }
+
+      switch ( str[ i ] )
+      {
+        case 'd':
+        case 'i':
+          spec.conversion = Conversion::SIGNED;
+          break;
+
+        case 'u':
+          spec.conversion = Conversion::UNSIGNED;
+          break;
+
+        case 'o':
+          spec.conversion = Conversion::OCTAL;
+          break;
+
+        case 'x':
+          spec.conversion = Conversion::HEX_LOWER;
+          break;
+
+        case 'X':
+          spec.conversion = Conversion::HEX_UPPER;
+          break;
+
+        case 'c':
+          spec.conversion = Conversion::CHARACTER;
+          break;
+
+        case 's':
+          spec.conversion = Conversion::STRING;
+          break;
+
+        case 'p':
+          spec.conversion = Conversion::POINTER;
+          break;
+
+        case 'f':
+        case 'F':
+          spec.conversion = Conversion::FIXED;
+          break;
+
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+          spec.conversion = Conversion::FLOAT;
+          break;
+
+        default:
+          out.valid = false;
+          return out;
+      }
+
+      spec.specLength          = ++i - spec.specBegin;
+      out.specs[ out.count++ ] = spec;
+      textBegin                = i;
+      escaped                  = false;
+    }
+
+    Spec &tail      = out.specs[ out.count ];
+    tail.textBegin  = textBegin;
+    tail.textLength = str.size() - textBegin;
+    tail.flags      = escaped ? FLAG_ESCAPED : 0;
+
+    return out;
+  }
+
+  /**
+   *  The parse of one ULOG_FMT() format string, done once at compile time
+   */
+  template<typename F>
+  struct Compiled
+  {
+    static constexpr std::string_view text = F::view();
+    static constexpr auto parsed           = parse<maxConversions( F::view() )>( F::view() );
+  };
+
+  /**
+   *  Checks if a type can be printed by a conversion
+   *
+   *  @param[in]  conversion  The conversion in the format string
+   *  @return bool
+   */
+  template<typename T>
+  constexpr bool accepts( const Conversion conversion )
+  {
+    using U = std::decay_t<T>;
+
+    switch ( conversion )
+    {
+      case Conversion::SIGNED:
+      case Conversion::UNSIGNED:
+      case Conversion::OCTAL:
+      case Conversion::HEX_LOWER:
+      case Conversion::HEX_UPPER:
+      case Conversion::CHARACTER:
+        return std::is_integral_v<U> || std::is_enum_v<U>;
+
+      case Conversion::STRING:
+        return std::is_same_v<U, const char *> || std::is_same_v<U, char *> || std::is_same_v<U, std::string_view> ||
+               std::is_same_v<U, std::string>;
+
+      case Conversion::POINTER:
+        return std::is_pointer_v<U> || std::is_null_pointer_v<U>;
+
+      case Conversion::FIXED:
+      case Conversion::FLOAT:
+        return std::is_floating_point_v<U>;
+
+      default:
+        return false;
+    }
+  }
+
+  /**
+   *  Bounded output for the formatter. Like snprintf it keeps one byte for the
+   *  terminator, but it always knows exactly how much it has written.
+   */
+  class Writer
+  {
+  public:
+    Writer( char *const buffer, const size_t size ) :
+        mBuffer( buffer ), mCapacity( size ? ( size - 1 ) : 0 ), mLength( 0 ), mTerminate( buffer && size )
+    {
+    }
+
+    void put( const char c )
+    {
+      if ( mLength < mCapacity )
+      {
+        mBuffer[ mLength++ ] = c;
+      }
+    }
+
+    void put( const char *const data, const size_t length )
+    {
+      const size_t count = std::min( length, mCapacity - mLength );
+      if ( count )
+      {
+        memcpy( mBuffer + mLength, data, count );
+        mLength += count;
+      }
+    }
+
+    void fill( const char c, const size_t count )
+    {
+      const size_t n = std::min( count, mCapacity - mLength );
+      memset( mBuffer + mLength, c, n );
+      mLength += n;
+    }
+
+    /**
+     *  Writes literal text from a format string
+     *
+     *  @param[in]  data      Start of the text
+     *  @param[in]  length    Length of the text
+     *  @param[in]  escaped   Whether "%%" inside it must become "%"
+     */
+    void text( const char *const data, const size_t length, const bool escaped )
+    {
+      if ( !escaped )
+      {
+        put( data, length );
+        return;
+      }
+
+      for ( size_t i = 0; i < length; i++ )
+      {
+        put( data[ i ] );
+        i += ( data[ i ] == '%' ) ? 1 : 0;
+      }
+    }
+
+    void integer( const uint64_t magnitude, const bool negative, const Spec &spec );
+    void pointer( const uintptr_t address, const Spec &spec );
+    void character( const char c, const Spec &spec );
+    void string( const char *const str, const Spec &spec );
+    void string( const char *const data, const size_t length, const Spec &spec );
+    void fixed( const double value, const Spec &spec, const char *const specText );
+    void floating( const double value, const Spec &spec, const char *const specText );
+
+    /**
+     *  Terminates the output
+     *
+     *  @return size_t    Bytes written, not counting the terminator
+     */
+    size_t finish()
+    {
+      if ( mTerminate )
+      {
+        mBuffer[ mLength ] = '\0';
+      }
+
+      return mLength;
+    }
+
+    size_t length() const
+    {
+      return mLength;
+    }
+
+  private:
+    char *const mBuffer;
+    const size_t mCapacity;
+    size_t mLength;
+    const bool mTerminate;
+
+    void padded( const char *const prefix, const size_t prefixLength, const char *const body, const size_t bodyLength,
+                 const size_t zeros, const Spec &spec );
+  };
+
+  /**
+   *  Writes one argument with the conversion the format string gave it
+   *
+   *  @param[in]  writer    Output
+   *  @param[in]  value     The argument
+   */
+  template<typename F, size_t I, typename T>
+  inline void writeArgument( Writer &writer, const T &value )
+  {
+    using U             = std::decay_t<T>;
+    constexpr Spec spec = Compiled<F>::parsed.specs[ I ];
+
+    static_assert( accepts<T>( spec.conversion ), "uLog: argument type doesn't suit its conversion in the format string" );
+
+    writer.text( Compiled<F>::text.data() + spec.textBegin, spec.textLength, spec.flags & FLAG_ESCAPED );
+
+    if constexpr ( ( spec.conversion == Conversion::STRING ) && std::is_convertible_v<const T &, const char *> )
+    {
+      writer.string( static_cast<const char *>( value ), spec );
+    }
+    else if constexpr ( spec.conversion == Conversion::STRING )
+    {
+      writer.string( value.data(), value.size(), spec );
+    }
+    else if constexpr ( spec.conversion == Conversion::POINTER )
+    {
+      writer.pointer( reinterpret_cast<uintptr_t>( static_cast<const void *>( value ) ), spec );
+    }
+    else if constexpr ( spec.conversion == Conversion::FIXED )
+    {
+      writer.fixed( static_cast<double>( value ), spec, Compiled<F>::text.data() + spec.specBegin );
+    }
+    else if constexpr ( spec.conversion == Conversion::FLOAT )
+    {
+      writer.floating( static_cast<double>( value ), spec, Compiled<F>::text.data() + spec.specBegin );
+    }
+    else
+    {
+      /*------------------------------------------------
+      Integers: enums print as their underlying type, and
+      unsigned conversions of a signed type see its bits
+      ------------------------------------------------*/
+      using Raw = typename std::conditional_t<std::is_enum_v<U>, std::underlying_type<U>, std::common_type<U>>::type;
+      const Raw raw = static_cast<Raw>( value );
+
+      if constexpr ( spec.conversion == Conversion::CHARACTER )
+      {
+        writer.character( static_cast<char>( raw ), spec );
+      }
+      else if constexpr ( std::is_same_v<Raw, bool> )
+      {
+        writer.integer( raw ? 1 : 0, false, spec );
+      }
+      else if constexpr ( ( spec.conversion == Conversion::SIGNED ) && std::is_signed_v<Raw> )
+      {
+        const int64_t signedValue = raw;
+        writer.integer( ( signedValue < 0 ) ? ( 0 - static_cast<uint64_t>( signedValue ) ) : static_cast<uint64_t>( signedValue ),
+                        signedValue < 0, spec );
+      }
+      else
+      {
+        writer.integer( static_cast<std::make_unsigned_t<Raw>>( raw ), false, spec );
+      }
+    }
+  }
+
+  template<typename F, typename... Args, size_t... I>
+  inline void writeArguments( Writer &writer, std::index_sequence<I...>, const Args &... args )
+  {
+    ( writeArgument<F, I>( writer, args ), ... );
+  }
+
+  /**
+   *  Formats into a Writer, which may already hold output
+   *
+   *  @param[in]  writer    Output
+   *  @param[in]  fmt       Format string from ULOG_FMT()
+   *  @param[in]  args      Arguments referenced by the format string
+   */
+  template<typename F, typename... Args>
+  inline std::enable_if_t<isLiteral<F>> formatTo( Writer &writer, F fmt, const Args &... args )
+  {
+    ( void )fmt;
+    using Parse = Compiled<F>;
+
+    static_assert( Parse::parsed.valid, "uLog: format string is malformed or uses an unsupported feature (e.g. '*' width)" );
+    static_assert( Parse::parsed.count == sizeof...( Args ), "uLog: format string and argument count differ" );
+
+    if constexpr ( Parse::parsed.valid && ( Parse::parsed.count == sizeof...( Args ) ) )
+    {
+      constexpr Spec tail = Parse::parsed.specs[ sizeof...( Args ) ];
+
+      writeArguments<F>( writer, std::index_sequence_for<Args...>{}, args... );
+      writer.text( Parse::text.data() + tail.textBegin, tail.textLength, tail.flags & FLAG_ESCAPED );
+    }
+  }
+
+  /**
+   *  Formats into a buffer using a compile time checked format string
+   *
+   *  @param[out] buffer    Output, always terminated if size is non-zero
+   *  @param[in]  size      Size of the buffer
+   *  @param[in]  fmt       Format string from ULOG_FMT()
+   *  @param[in]  args      Arguments referenced by the format string
+   *  @return size_t        Exact bytes written, not counting the terminator
+   */
+  template<typename F, typename... Args>
+  inline std::enable_if_t<isLiteral<F>, size_t> format( char *const buffer, const size_t size, F fmt, const Args &... args )
+  {
+    Writer writer( buffer, size );
+    formatTo( writer, fmt, args... );
+    return writer.finish();
+  }
+
+  /**
+   *  Formats into a buffer with snprintf, for format strings only known at
+   *  runtime
+   *
+   *  @param[out] buffer    Output, always terminated if size is non-zero
+   *  @param[in]  size      Size of the buffer
+   *  @param[in]  str       printf style format string
+   *  @param[in]  args      Arguments referenced by the format string
+   *  @return size_t        Exact bytes written, zero on an encoding error
+   */
+  template<typename... Args>
+  inline size_t format( char *const buffer, const size_t size, const char *const str, const Args &... args )
+  {
+    const int written = snprintf( buffer, size, str, args... );
+    return ( written < 0 ) ? 0 : std::min<size_t>( written, size ? ( size - 1 ) : 0 );
+  }
+}    // namespace uLog::Format
+
+#endif /* !MICRO_LOGGER_FORMAT_HPP */
@@ -0,0 +1,97 @@
+/********************************************************************************
+ *  File Name:
+ *    macros.hpp
+ *
+ *  Description:
+ *    Logging entry points that honor ULOG_COMPILE_TIME_MIN_LEVEL. Calls below
+ *    that level sit in a discarded 'if constexpr' branch, so the compiler still
+ *    type checks them but emits no code, strings or argument evaluation.
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_MACROS_HPP
+#define MICRO_LOGGER_MACROS_HPP
+
+/* uLog Includes */
+#include <uLog/config.hpp>
+#include <uLog/format.hpp>
+#include <uLog/types.hpp>
+
+/**
+ *  The module ID of the current translation unit, as set by ULOG_MODULE
+ */
+#define ULOG_THIS_MODULE static_cast<::uLog::ModuleId>( ULOG_MODULE )
+
+/**
+ *  Logs raw bytes to every registered sink. See uLog::log().
+ *
+ *  @param[in]  lvl       Compile time constant uLog::Level
+ *  @param[in]  msg       Message to be logged
+ *  @param[in]  len       Length of the message
+ */
+#define ULOG_LOG( lvl, msg, len )                     \
+  do                                                  \
+  {                                                   \
+    if constexpr ( ::uLog::isCompiledIn( lvl ) )      \
+    {                                                 \
+      ::uLog::log( ULOG_THIS_MODULE, lvl, msg, len ); \
+    }                                                 \
+  } while ( 0 )
+
+/**
+ *  Logs a formatted message through a specific sink. See SinkInterface::flog().
+ *
+ *  @param[in]  sink      SinkHandle to log with
+ *  @param[in]  lvl       Compile time constant uLog::Level
+ *  @param[in]  fmt       printf style format string literal, checked against
+ *                        the arguments at compile time (see ULOG_FMT())
+ */
+#define ULOG_SINK_FLOG( sink, lvl, fmt, ... )                \
+  do                                                         \
+  {                                                          \
+    if constexpr ( ::uLog::isCompiledIn( lvl ) )             \
+    {                                                        \
+      ( sink )->flog( lvl, ULOG_FMT( fmt ), ##__VA_ARGS__ ); \
+    }                                                        \
+  } while ( 0 )
+
+/**
+ *  Formats a message once and logs it to every registered sink on behalf of a
+ *  specific module. See uLog::flog().
+ *
+ *  @param[in]  module    uLog::ModuleId the message belongs to
+ *  @param[in]  lvl       Compile time constant uLog::Level
+ *  @param[in]  fmt       printf style format string literal, checked against
+ *                        the arguments at compile time (see ULOG_FMT())
+ */
+#define ULOG_MODULE_FLOG( module, lvl, fmt, ... )                  \
+  do                                                               \
+  {                                                                \
+    if constexpr ( ::uLog::isCompiledIn( lvl ) )                   \
+    {                                                              \
+      ::uLog::flog( module, lvl, ULOG_FMT( fmt ), ##__VA_ARGS__ ); \
+    }                                                              \
+  } while ( 0 )
+
+/**
+ *  Formats a message once and logs it to every registered sink, tagged with the
+ *  translation unit's ULOG_MODULE. See uLog::flog().
+ *
+ *  @param[in]  lvl       Compile time constant uLog::Level
+ *  @param[in]  fmt       printf style format string literal
+ */
+#define ULOG_FLOG( lvl, fmt, ... ) ULOG_MODULE_FLOG( ULOG_THIS_MODULE, lvl, fmt, ##__VA_ARGS__ )
+
+/*-------------------------------------------------------------------------------
+Per level shortcuts to every registered sink
+-------------------------------------------------------------------------------*/
+#define ULOG_TRACE( fmt, ... ) ULOG_FLOG( ::uLog::Level::LVL_TRACE, fmt, ##__VA_ARGS__ )
+#define ULOG_DEBUG( fmt, ... ) ULOG_FLOG( ::uLog::Level::LVL_DEBUG, fmt, ##__VA_ARGS__ )
+#define ULOG_INFO( fmt, ... ) ULOG_FLOG( ::uLog::Level::LVL_INFO, fmt, ##__VA_ARGS__ )
+#define ULOG_WARN( fmt, ... ) ULOG_FLOG( ::uLog::Level::LVL_WARN, fmt, ##__VA_ARGS__ )
+#define ULOG_ERROR( fmt, ... ) ULOG_FLOG( ::uLog::Level::LVL_ERROR, fmt, ##__VA_ARGS__ )
+#define ULOG_FATAL( fmt, ... ) ULOG_FLOG( ::uLog::Level::LVL_FATAL, fmt, ##__VA_ARGS__ )
+
+#endif /* !MICRO_LOGGER_MACROS_HPP */
@@ -0,0 +1,178 @@
+/********************************************************************************
+ *  File Name:
+ *    metrics.hpp
+ *
+ *  Description:
+ *    Self-metrics kept by uLog about its own cost. Counters are relaxed
+ *    atomics bumped on the log path; each sink also keeps a histogram of the
+ *    time spent inside its log() call. Query them with uLog::getMetrics() and
+ *    SinkInterface::getLatency(), or have uLog::setMetricsDump() write a report
+ *    to a sink periodically. Compiled out unless ULOG_ENABLE_METRICS is set.
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_METRICS_HPP
+#define MICRO_LOGGER_METRICS_HPP
+
+/* C++ Includes */
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/* uLog Includes */
+#include <uLog/config.hpp>
+#include <uLog/types.hpp>
+
+namespace uLog
+{
+  /**
+   *  Number of latency buckets. Bucket 0 holds calls under 256ns, bucket N
+   *  those in [2^(N+7), 2^(N+8)) ns and the last one everything slower.
+   */
+  static constexpr size_t LatencyBuckets = 20;
+
+  /**
+   *  Point in time copy of a sink's latency histogram
+   */
+  struct LatencyStats
+  {
+    size_t count;                                 /**< Calls recorded */
+    uint64_t totalNs;                             /**< Sum of all call times */
+    uint64_t maxNs;                               /**< Slowest call */
+    std::array<size_t, LatencyBuckets> buckets;   /**< Calls per power of two bucket */
+
+    /**
+     *  Upper bound of the time a bucket covers
+     *
+     *  @param[in]  bucket    Bucket index
+     *  @return uint64_t      Nanoseconds, or UINT64_MAX for the last bucket
+     */
+    static constexpr uint64_t bucketLimitNs( const size_t bucket )
+    {
+      return ( bucket < ( LatencyBuckets - 1 ) ) ? ( 1ull << ( bucket + 8 ) ) : UINT64_MAX;
+    }
+
+    /**
+     *  Estimates a percentile as the upper bound of the bucket it falls in.
+     *  Precise to within a factor of two, capped at the slowest call seen.
+     *
+     *  @param[in]  percent   Percentile to find, 0 to 100
+     *  @return uint64_t      Nanoseconds
+     */
+    uint64_t percentileNs( const size_t percent ) const
+    {
+      const size_t target = ( count * percent + 99 ) / 100;
+      size_t seen         = 0;
+
+      for ( size_t i = 0; i < buckets.size(); i++ )
+      {
+        seen += buckets[ i ];
+        if ( seen && ( seen >= target ) )
+        {
+          return ( bucketLimitNs( i ) < maxNs ) ? bucketLimitNs( i ) : maxNs;
+        }
+      }
+
+      return maxNs;
+    }
+  };
+
+  /**
+   *  Histogram of how long calls take. Written by one thread at a time (the
+   *  holder of the sink lock) and readable from any thread.
+   */
+  class LatencyHistogram
+  {
+  public:
+    LatencyHistogram()
+    {
+      reset();
+    }
+
+    /**
+     *  Adds one call to the histogram
+     *
+     *  @param[in]  ns        How long the call took
+     */
+    void record( const uint64_t ns )
+    {
+      size_t bucket = 0;
+
+      if ( ns >= 256 )
+      {
+        bucket = static_cast<size_t>( 63 - __builtin_clzll( ns ) ) - 7;
+        bucket = ( bucket < LatencyBuckets ) ? bucket : ( LatencyBuckets - 1 );
+      }
+
+      mBuckets[ bucket ].fetch_add( 1, std::memory_order_relaxed );
+      mCount.fetch_add( 1, std::memory_order_relaxed );
+      mTotalNs.fetch_add( ns, std::memory_order_relaxed );
+
+      if ( ns > mMaxNs.load( std::memory_order_relaxed ) )
+      {
+        mMaxNs.store( ns, std::memory_order_relaxed );
+      }
+    }
+
+    /**
+     *  Copies out the current state. Counts recorded while the copy is made
+     *  may show up in some fields and not others.
+     *
+     *  @return LatencyStats
+     */
+    LatencyStats snapshot() const
+    {
+      LatencyStats stats;
+
+      stats.count   = mCount.load( std::memory_order_relaxed );
+      stats.totalNs = mTotalNs.load( std::memory_order_relaxed );
+      stats.maxNs   = mMaxNs.load( std::memory_order_relaxed );
+
+      for ( size_t i = 0; i < stats.buckets.size(); i++ )
+      {
+        stats.buckets[ i ] = mBuckets[ i ].load( std::memory_order_relaxed );
+      }
+
+      return stats;
+    }
+
+    /**
+     *  Clears the histogram
+     */
+    void reset()
+    {
+      for ( auto &bucket : mBuckets )
+      {
+        bucket.store( 0, std::memory_order_relaxed );
+      }
+
+      mCount.store( 0, std::memory_order_relaxed );
+      mTotalNs.store( 0, std::memory_order_relaxed );
+      mMaxNs.store( 0, std::memory_order_relaxed );
+    }
+
+  private:
+    std::array<std::atomic<size_t>, LatencyBuckets> mBuckets;
+    std::atomic<size_t> mCount;
+    std::atomic<uint64_t> mTotalNs;
+    std::atomic<uint64_t> mMaxNs;
+  };
+
+  /**
+   *  Point in time copy of the process wide counters
+   */
+  struct Metrics
+  {
+    std::array<size_t, LevelCount> logged;   /**< Messages accepted, per level */
+    std::array<size_t, LevelCount> filtered; /**< Rejected by the level filters, or deferred records a text sink skipped */
+    size_t lockTimeouts;                     /**< Lock waits that ran out: RESULT_LOCKED and sink backpressure */
+    size_t lockWaits;                        /**< Times a sink lock was found taken */
+    uint64_t lockWaitNs;                     /**< Time spent waiting on those locks */
+    size_t queueDrops;                       /**< Messages turned away by a full async queue */
+  };
+}    // namespace uLog
+
+#endif /* !MICRO_LOGGER_METRICS_HPP */
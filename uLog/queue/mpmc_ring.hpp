@@ -0,0 +1,206 @@
+/********************************************************************************
+ *  File Name:
+ *    mpmc_ring.hpp
+ *
+ *  Description:
+ *    Bounded lock-free multi-producer/multi-consumer ring buffer. Each cell
+ *    carries its own sequence counter so that producers and consumers only
+ *    contend on a single atomic index, never on a lock.
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_MPMC_RING_HPP
+#define MICRO_LOGGER_MPMC_RING_HPP
+
+/* C++ Includes */
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace uLog::Queue
+{
+  /**
+   *  Size of a cache line on the targets we care about. Used to keep the
+   *  producer and consumer indices from false sharing.
+   */
+  static constexpr size_t CacheLineSize = 64;
+
+  /**
+   *  Fixed capacity ring of elements of type T. Elements are written and read
+   *  in place through callables so that no intermediate copy of T is needed.
+   *
+   *  @tparam T         Element type. Must be default constructible.
+   *  @tparam CAPACITY  Number of elements. Must be a power of two.
+   */
+  template<typename T, size_t CAPACITY>
+  class MPMCRing
+  {
+    static_assert( CAPACITY >= 2, "Ring capacity must be at least 2" );
+    static_assert( ( CAPACITY & ( CAPACITY - 1 ) ) == 0, "Ring capacity must be a power of two" );
+
+  public:
+    MPMCRing()
+    {
+      for ( size_t i = 0; i < CAPACITY; i++ )
+      {
+        mCells[ i ].sequence.store( i, std::memory_order_relaxed );
+      }
+
+      mEnqueuePos.store( 0, std::memory_order_relaxed );
+      mDequeuePos.store( 0, std::memory_order_relaxed );
+    }
+
+    MPMCRing( const MPMCRing & ) = delete;
+    MPMCRing &operator=( const MPMCRing & ) = delete;
+
+    /**
+     *  Attempts to claim a free cell and fill it with the given writer
+     *
+     *  @param[in]  writer    Callable of the form void( T & )
+     *  @return bool          True if the element was queued, false if full
+     */
+    template<typename Writer>
+    bool push( Writer &&writer )
+    {
+      size_t ticket;
+      T *const element = claim( ticket );
+
+      if ( !element )
+      {
+        return false;
+      }
+
+      writer( *element );
+      publish( ticket );
+      return true;
+    }
+
+    /**
+     *  Claims a free cell to be filled in place. The cell must be handed to
+     *  publish() once written. Consumers stop at an unpublished cell, so keep
+     *  the time between the two short.
+     *
+     *  @param[out] ticket    Identifies the cell to publish()
+     *  @return T *           The cell's element, or nullptr if full
+     */
+    T *claim( size_t &ticket )
+    {
+      size_t pos = mEnqueuePos.load( std::memory_order_relaxed );
+
+      while ( true )
+      {
+        Cell *cell    = &mCells[ pos & Mask ];
+        size_t seq    = cell->sequence.load( std::memory_order_acquire );
+        intptr_t diff = static_cast<intptr_t>( seq ) - static_cast<intptr_t>( pos );
+
+        if ( diff == 0 )
+        {
+          if ( mEnqueuePos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+          {
+            ticket = pos;
+            return &cell->data;
+          }
+        }
+        else if ( diff < 0 )
+        {
+          return nullptr;
+        }
+        else
+        {
+          pos = mEnqueuePos.load( std::memory_order_relaxed );
+        }
+      }
+    }
+
+    /**
+     *  Makes a claimed cell visible to the consumers
+     *
+     *  @param[in]  ticket    Value returned through claim()
+     *  @return void
+     */
+    void publish( const size_t ticket )
+    {
+      mCells[ ticket & Mask ].sequence.store( ticket + 1, std::memory_order_release );
+    }
+
+    /**
+     *  Attempts to remove the oldest element, handing it to the given reader
+     *  before the cell is released back to the producers.
+     *
+     *  @param[in]  reader    Callable of the form void( T & )
+     *  @return bool          True if an element was consumed, false if empty
+     */
+    template<typename Reader>
+    bool pop( Reader &&reader )
+    {
+      Cell *cell = nullptr;
+      size_t pos = mDequeuePos.load( std::memory_order_relaxed );
+
+      while ( true )
+      {
+        cell          = &mCells[ pos & Mask ];
+        size_t seq    = cell->sequence.load( std::memory_order_acquire );
+        intptr_t diff = static_cast<intptr_t>( seq ) - static_cast<intptr_t>( pos + 1 );
+
+        if ( diff == 0 )
+        {
+          if ( mDequeuePos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+          {
+            break;
+          }
+        }
+        else if ( diff < 0 )
+        {
+          return false;
+        }
+        else
+        {
+          pos = mDequeuePos.load( std::memory_order_relaxed );
+        }
+      }
+
+      reader( cell->data );
+      cell->sequence.store( pos + Mask + 1, std::memory_order_release );
+      return true;
+    }
+
+    /**
+     *  Checks if the ring currently holds no elements. Only a hint when other
+     *  threads are actively pushing or popping.
+     *
+     *  @return bool
+     */
+    bool empty() const
+    {
+      return mEnqueuePos.load( std::memory_order_acquire ) == mDequeuePos.load( std::memory_order_acquire );
+    }
+
+    /**
+     *  Gets the fixed number of elements the ring can hold
+     *
+     *  @return size_t
+     */
+    static constexpr size_t capacity()
+    {
+      return CAPACITY;
+    }
+
+  private:
+    static constexpr size_t Mask = CAPACITY - 1;
+
+    struct Cell
+    {
+      std::atomic<size_t> sequence;
+      T data;
+    };
+
+    alignas( CacheLineSize ) std::array<Cell, CAPACITY> mCells;
+    alignas( CacheLineSize ) std::atomic<size_t> mEnqueuePos;
+    alignas( CacheLineSize ) std::atomic<size_t> mDequeuePos;
+  };
+}    // namespace uLog::Queue
+
+#endif /* !MICRO_LOGGER_MPMC_RING_HPP */
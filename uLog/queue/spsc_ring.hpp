@@ -0,0 +1,160 @@
+/********************************************************************************
+ *  File Name:
+ *    spsc_ring.hpp
+ *
+ *  Description:
+ *    Bounded lock-free single-producer/single-consumer ring buffer. Same cell
+ *    layout as MPMCRing, but each index has exactly one writer, so neither side
+ *    needs a read-modify-write and the producer's index never leaves its core.
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_SPSC_RING_HPP
+#define MICRO_LOGGER_SPSC_RING_HPP
+
+/* C++ Includes */
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/* uLog Includes */
+#include <uLog/queue/mpmc_ring.hpp>
+
+namespace uLog::Queue
+{
+  /**
+   *  Fixed capacity ring of elements of type T, written in place by one thread
+   *  and read in place by one other. The consumer can look at the oldest
+   *  element before deciding to take it, which is what lets several rings be
+   *  merged in order.
+   *
+   *  @tparam T         Element type. Must be default constructible.
+   *  @tparam CAPACITY  Number of elements. Must be a power of two.
+   */
+  template<typename T, size_t CAPACITY>
+  class SPSCRing
+  {
+    static_assert( CAPACITY >= 2, "Ring capacity must be at least 2" );
+    static_assert( ( CAPACITY & ( CAPACITY - 1 ) ) == 0, "Ring capacity must be a power of two" );
+
+  public:
+    SPSCRing()
+    {
+      for ( size_t i = 0; i < CAPACITY; i++ )
+      {
+        mCells[ i ].sequence.store( i, std::memory_order_relaxed );
+      }
+
+      mEnqueuePos.store( 0, std::memory_order_relaxed );
+      mDequeuePos.store( 0, std::memory_order_relaxed );
+    }
+
+    SPSCRing( const SPSCRing & ) = delete;
+    SPSCRing &operator=( const SPSCRing & ) = delete;
+
+    /**
+     *  Claims the next free cell to be filled in place. Producer only. More
+     *  than one cell may be claimed at a time, but the consumer stops at the
+     *  oldest unpublished one.
+     *
+     *  @param[out] ticket    Identifies the cell to publish()
+     *  @return T *           The cell's element, or nullptr if full
+     */
+    T *claim( size_t &ticket )
+    {
+      const size_t pos = mEnqueuePos.load( std::memory_order_relaxed );
+      Cell *const cell = &mCells[ pos & Mask ];
+
+      if ( cell->sequence.load( std::memory_order_acquire ) != pos )
+      {
+        return nullptr;
+      }
+
+      mEnqueuePos.store( pos + 1, std::memory_order_relaxed );
+      ticket = pos;
+      return &cell->data;
+    }
+
+    /**
+     *  Makes a claimed cell visible to the consumer. Producer only.
+     *
+     *  @param[in]  ticket    Value returned through claim()
+     *  @return void
+     */
+    void publish( const size_t ticket )
+    {
+      mCells[ ticket & Mask ].sequence.store( ticket + 1, std::memory_order_release );
+    }
+
+    /**
+     *  Gets the oldest element without removing it. Consumer only.
+     *
+     *  @return T *           The element, or nullptr if there is none yet
+     */
+    T *front()
+    {
+      const size_t pos = mDequeuePos.load( std::memory_order_relaxed );
+      Cell *const cell = &mCells[ pos & Mask ];
+
+      if ( cell->sequence.load( std::memory_order_acquire ) != ( pos + 1 ) )
+      {
+        return nullptr;
+      }
+
+      return &cell->data;
+    }
+
+    /**
+     *  Releases the element returned by front() back to the producer.
+     *  Consumer only.
+     *
+     *  @return void
+     */
+    void pop()
+    {
+      const size_t pos = mDequeuePos.load( std::memory_order_relaxed );
+
+      mCells[ pos & Mask ].sequence.store( pos + Mask + 1, std::memory_order_release );
+      mDequeuePos.store( pos + 1, std::memory_order_relaxed );
+    }
+
+    /**
+     *  Checks if every claimed cell has been consumed. Only a hint while the
+     *  producer is active.
+     *
+     *  @return bool
+     */
+    bool empty() const
+    {
+      return mEnqueuePos.load( std::memory_order_acquire ) == mDequeuePos.load( std::memory_order_acquire );
+    }
+
+    /**
+     *  Gets the fixed number of elements the ring can hold
+     *
+     *  @return size_t
+     */
+    static constexpr size_t capacity()
+    {
+      return CAPACITY;
+    }
+
+  private:
+    static constexpr size_t Mask = CAPACITY - 1;
+
+    struct Cell
+    {
+      std::atomic<size_t> sequence;
+      T data;
+    };
+
+    alignas( CacheLineSize ) std::array<Cell, CAPACITY> mCells;
+    alignas( CacheLineSize ) std::atomic<size_t> mEnqueuePos;
+    alignas( CacheLineSize ) std::atomic<size_t> mDequeuePos;
+  };
+}    // namespace uLog::Queue
+
+#endif /* !MICRO_LOGGER_SPSC_RING_HPP */
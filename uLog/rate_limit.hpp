@@ -0,0 +1,231 @@
+/********************************************************************************
+ *  File Name:
+ *    rate_limit.hpp
+ *
+ *  Description:
+ *    Per call site rate limiting and sampling for logging from hot loops. Each
+ *    call site owns a static, constant initialized limiter that is updated with
+ *    a single 32-bit compare-and-swap, so there are no locks or allocations.
+ *    When a site is allowed to emit again, the number of messages it dropped
+ *    in the meantime is appended to the message.
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_RATE_LIMIT_HPP
+#define MICRO_LOGGER_RATE_LIMIT_HPP
+
+/* C++ Includes */
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+/* Chimera Includes */
+#include <Chimera/common>
+
+/* uLog Includes */
+#include <uLog/config.hpp>
+#include <uLog/scratch.hpp>
+#include <uLog/types.hpp>
+#include <uLog/ulog.hpp>
+
+/**
+ *  Formats and logs a message at most 'rate' times per second on average, with
+ *  bursts of up to 'burst' messages. Both must be compile time constants.
+ *
+ *  Example:  ULOG_RATE_LIMITED( uLog::Level::LVL_WARN, 5, 10, "Sensor %d fault", id );
+ */
+#define ULOG_RATE_LIMITED( lvl, rate, burst, fmt, ... )                                                             \
+  do                                                                                                                \
+  {                                                                                                                 \
+    if constexpr ( ::uLog::isCompiledIn( lvl ) )                                                                    \
+    {                                                                                                               \
+      static ::uLog::RateLimiter ulogSiteLimiter_( rate, burst );                                                   \
+      const auto ulogAdmission_ = ulogSiteLimiter_.tryAcquire();                                                    \
+      if ( ulogAdmission_.allowed )                                                                                 \
+      {                                                                                                             \
+        ::uLog::flogSuppressed( ULOG_THIS_MODULE, lvl, ulogAdmission_.suppressed, ULOG_FMT( fmt ), ##__VA_ARGS__ ); \
+      }                                                                                                             \
+    }                                                                                                               \
+  } while ( 0 )
+
+/**
+ *  Formats and logs only the first of every 'n' calls. 'n' must be a compile
+ *  time constant.
+ *
+ *  Example:  ULOG_EVERY_N( uLog::Level::LVL_DEBUG, 1000, "Loop tick %u", tick );
+ */
+#define ULOG_EVERY_N( lvl, n, fmt, ... )                                                                            \
+  do                                                                                                                \
+  {                                                                                                                 \
+    if constexpr ( ::uLog::isCompiledIn( lvl ) )                                                                    \
+    {                                                                                                               \
+      static ::uLog::Sampler ulogSiteSampler_( n );                                                                 \
+      const auto ulogAdmission_ = ulogSiteSampler_.tryAcquire();                                                    \
+      if ( ulogAdmission_.allowed )                                                                                 \
+      {                                                                                                             \
+        ::uLog::flogSuppressed( ULOG_THIS_MODULE, lvl, ulogAdmission_.suppressed, ULOG_FMT( fmt ), ##__VA_ARGS__ ); \
+      }                                                                                                             \
+    }                                                                                                               \
+  } while ( 0 )
+
+namespace uLog
+{
+  /**
+   *  Outcome of asking a limiter for permission to log
+   */
+  struct Admission
+  {
+    bool allowed;        /**< The caller may emit its message */
+    uint32_t suppressed; /**< Messages dropped since the last allowed one */
+  };
+
+  /**
+   *  Lock-free token bucket, kept in its GCRA form: the only state is the time
+   *  the next message is due if the bucket were drained at exactly 'rate'.
+   *  A message is let through while that time is no more than a burst's worth
+   *  of intervals in the future. One 32-bit word in microseconds, so a single
+   *  compare-and-swap updates it even on targets without 64-bit atomics.
+   */
+  class RateLimiter
+  {
+  public:
+    /**
+     *  @param[in]  rate    Messages per second, on average
+     *  @param[in]  burst   Most messages let through back to back
+     */
+    constexpr RateLimiter( const uint32_t rate, const uint32_t burst ) :
+        mInterval( MicrosPerSecond / std::max<uint32_t>( rate, 1 ) ),
+        mTolerance( static_cast<uint32_t>( std::min<uint64_t>( static_cast<uint64_t>( mInterval ) * ( std::max<uint32_t>( burst, 1 ) - 1 ),
+                                                               MaxTolerance ) ) ),
+        mDue( 0 ), mSuppressed( 0 )
+    {
+    }
+
+    /**
+     *  Takes a token if one is available
+     *  @return Admission
+     */
+    Admission tryAcquire()
+    {
+      uint32_t due = mDue.load( std::memory_order_relaxed );
+
+      while ( true )
+      {
+        /*------------------------------------------------
+        Read the clock on every attempt: another thread may
+        have moved 'due' on with a later time than ours.
+        ------------------------------------------------*/
+        const uint32_t now  = static_cast<uint32_t>( Chimera::micros() );
+        const int32_t ahead = static_cast<int32_t>( due - now );
+
+        /*------------------------------------------------
+        Behind the clock means the bucket is full. So does
+        being further ahead than is ever legitimate, which
+        only happens once the clock has wrapped past a long
+        idle limiter.
+        ------------------------------------------------*/
+        uint32_t start = due;
+        if ( ( ahead <= 0 ) || ( static_cast<uint32_t>( ahead ) > ( mTolerance + mInterval ) ) )
+        {
+          start = now;
+        }
+        else if ( static_cast<uint32_t>( ahead ) > mTolerance )
+        {
+          mSuppressed.fetch_add( 1, std::memory_order_relaxed );
+          return { false, 0 };
+        }
+
+        if ( mDue.compare_exchange_weak( due, start + mInterval, std::memory_order_relaxed ) )
+        {
+          return { true, mSuppressed.exchange( 0, std::memory_order_relaxed ) };
+        }
+      }
+    }
+
+  private:
+    static constexpr uint32_t MicrosPerSecond = 1000000u;
+    static constexpr uint64_t MaxTolerance    = 0x3FFFFFFFu; /**< Keeps tolerance + interval well inside int32_t */
+
+    static_assert( std::atomic<uint32_t>::is_always_lock_free, "RateLimiter needs lock-free 32-bit atomics" );
+
+    const uint32_t mInterval;  /**< Microseconds between messages at the average rate */
+    const uint32_t mTolerance; /**< How far ahead of the clock 'due' may run, a burst less one interval */
+    std::atomic<uint32_t> mDue;
+    std::atomic<uint32_t> mSuppressed;
+  };
+
+  /**
+   *  Lets the first of every N calls through
+   */
+  class Sampler
+  {
+  public:
+    constexpr Sampler( const uint32_t n ) : mPeriod( std::max<uint32_t>( n, 1 ) ), mCount( 0 )
+    {
+    }
+
+    /**
+     *  Counts a call and reports if it is the one to emit
+     *  @return Admission
+     */
+    Admission tryAcquire()
+    {
+      const uint32_t count = mCount.fetch_add( 1, std::memory_order_relaxed );
+      const bool allowed   = ( count % mPeriod ) == 0;
+
+      return { allowed, ( allowed && count ) ? mPeriod - 1 : 0 };
+    }
+
+  private:
+    const uint32_t mPeriod;
+    std::atomic<uint32_t> mCount;
+  };
+
+  /**
+   *  Same as uLog::flog(), but notes how many messages were suppressed ahead of
+   *  this one. The note goes before a trailing newline if there is one.
+   *
+   *  @param[in]  module      The module the message came from
+   *  @param[in]  lvl         The severity level of the message to be logged
+   *  @param[in]  suppressed  Number of messages dropped before this one
+   *  @param[in]  str         ULOG_FMT() format string, or a printf style one
+   *  @param[in]  args        Arguments referenced by the format string
+   *  @return Result
+   */
+  template<typename Fmt, typename... Args>
+  Result flogSuppressed( const ModuleId module, const Level lvl, const uint32_t suppressed, const Fmt &str,
+                         Args const &... args )
+  {
+    if ( !suppressed )
+    {
+      return flog( module, lvl, str, args... );
+    }
+    else if ( !isLevelEnabled( module, lvl ) )
+    {
+      return Result::RESULT_FAIL;
+    }
+
+    ScratchBuffer scratch;
+    if ( !scratch.valid() )
+    {
+      return Result::RESULT_FULL;
+    }
+
+    /*------------------------------------------------
+    Append the note, keeping any trailing newline last
+    ------------------------------------------------*/
+    size_t length      = Format::format( scratch.data(), scratch.size(), str, args... );
+    const bool newLine = length && ( scratch.data()[ length - 1 ] == '\n' );
+    length -= newLine ? 1 : 0;
+
+    length += Format::format( scratch.data() + length, scratch.size() - length, ULOG_FMT( " [%u suppressed]%s" ), suppressed,
+                              newLine ? "\n" : "" );
+
+    return log( module, lvl, scratch.data(), length );
+  }
+}    // namespace uLog
+
+#endif /* !MICRO_LOGGER_RATE_LIMIT_HPP */
@@ -0,0 +1,61 @@
+/********************************************************************************
+ *  File Name:
+ *    record.cpp
+ *
+ *  Description:
+ *    Binary record encoding
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* C++ Includes */
+#include <algorithm>
+#include <cstring>
+
+/* uLog Includes */
+#include <uLog/record.hpp>
+
+namespace uLog
+{
+  static uint8_t *putLE( uint8_t *out, uint64_t value, const size_t bytes )
+  {
+    for ( size_t i = 0; i < bytes; i++ )
+    {
+      *out++ = static_cast<uint8_t>( value );
+      value >>= 8;
+    }
+
+    return out;
+  }
+
+  void encodeRecordHeader( const RecordInfo &info, const size_t length, uint8_t *const out )
+  {
+    uint8_t *pos = out;
+
+    *pos++ = RecordMagic;
+    *pos++ = static_cast<uint8_t>( ( static_cast<uint8_t>( info.type ) << 4 ) | ( static_cast<uint8_t>( info.level ) & 0x0F ) );
+    pos    = putLE( pos, length, sizeof( uint16_t ) );
+    pos    = putLE( pos, info.module, sizeof( uint16_t ) );
+    pos    = putLE( pos, info.sequence, sizeof( uint32_t ) );
+    putLE( pos, info.tick, sizeof( uint64_t ) );
+  }
+
+  size_t encodeRecord( const RecordInfo &info, const void *const payload, const size_t length, uint8_t *const out,
+                       const size_t size )
+  {
+    if ( !out || ( size < RecordHeaderSize ) )
+    {
+      return 0;
+    }
+
+    const size_t fit = std::min( { length, size - RecordHeaderSize, RecordMaxPayload } );
+    encodeRecordHeader( info, fit, out );
+
+    if ( fit )
+    {
+      memcpy( out + RecordHeaderSize, payload, fit );
+    }
+
+    return RecordHeaderSize + fit;
+  }
+}    // namespace uLog
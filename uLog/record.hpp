@@ -0,0 +1,99 @@
+/********************************************************************************
+ *  File Name:
+ *    record.hpp
+ *
+ *  Description:
+ *    Compact binary framing for log records. A sink that selects
+ *    RecordFormat::BINARY receives every message wrapped in a fixed header, so
+ *    captures can be filtered by level or module and merged by sequence without
+ *    parsing any text. Decode with 'tools/ulog_decode.py records'.
+ *
+ *    Record layout (little endian, no padding):
+ *      u8    RecordMagic
+ *      u8    RecordType in the high nibble, Level in the low nibble
+ *      u16   Payload length
+ *      u16   Module ID
+ *      u32   Sequence number, shared by all records from this process
+ *      u64   Raw tick, see uLog/timestamp.hpp
+ *      ...   Payload
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_RECORD_HPP
+#define MICRO_LOGGER_RECORD_HPP
+
+/* C++ Includes */
+#include <cstddef>
+#include <cstdint>
+
+/* uLog Includes */
+#include <uLog/config.hpp>
+#include <uLog/timestamp.hpp>
+#include <uLog/types.hpp>
+
+namespace uLog
+{
+  /**
+   *  What a sink's log() receives
+   */
+  enum class RecordFormat : uint8_t
+  {
+    TEXT,  /**< The payload bytes only */
+    BINARY /**< The payload wrapped in a record header */
+  };
+
+  /**
+   *  How the payload of a record should be interpreted
+   */
+  enum class RecordType : uint8_t
+  {
+    TEXT,       /**< Formatted text */
+    DEFERRED,   /**< A uLog::Deferred record */
+    CALIBRATION /**< Three u64: tick rate, tick and matching Unix time in ns */
+  };
+
+  /**
+   *  Everything known about a record besides its payload
+   */
+  struct RecordInfo
+  {
+    RecordType type;
+    Level level;
+    ModuleId module;
+    uint32_t sequence;
+    Tick tick;
+  };
+
+  static constexpr uint8_t RecordMagic     = 0xB5;
+  static constexpr size_t RecordHeaderSize = 18;
+  static constexpr size_t RecordMaxPayload = 0xFFFF;
+  static constexpr size_t RecordMaxLength  = RecordHeaderSize + ULOG_MAX_SNPRINTF_BUFFER_LENGTH; /**< Largest record built by dispatch */
+
+  /**
+   *  Writes only the record header, for payloads already built in place
+   *  right behind it
+   *
+   *  @param[in]  info      Header contents
+   *  @param[in]  length    Payload length, at most RecordMaxPayload
+   *  @param[out] out       Destination, at least RecordHeaderSize bytes
+   *  @return void
+   */
+  void encodeRecordHeader( const RecordInfo &info, const size_t length, uint8_t *const out );
+
+  /**
+   *  Writes a record header followed by as much of the payload as fits
+   *
+   *  @param[in]  info      Header contents
+   *  @param[in]  payload   Payload bytes
+   *  @param[in]  length    Payload length
+   *  @param[out] out       Destination buffer
+   *  @param[in]  size      Size of the destination buffer
+   *  @return size_t        Bytes written, or zero if not even the header fits
+   */
+  size_t encodeRecord( const RecordInfo &info, const void *const payload, const size_t length, uint8_t *const out,
+                       const size_t size );
+}    // namespace uLog
+
+#endif /* !MICRO_LOGGER_RECORD_HPP */
@@ -0,0 +1,141 @@
+/********************************************************************************
+ *  File Name:
+ *    reservation.hpp
+ *
+ *  Description:
+ *    Zero copy logging. A Reservation lends out space for one message right
+ *    where it will be delivered from, so a producer can serialize or format
+ *    in place instead of building the message somewhere and having it copied:
+ *
+ *      uLog::Reservation frame( uLog::Level::LVL_INFO, sizeof( SensorFrame ) );
+ *      if ( frame.valid() )
+ *      {
+ *        const size_t length = serialize( sensor, frame.data(), frame.size() );
+ *        frame.commit( length );
+ *      }
+ *
+ *    The space comes from, in order of preference:
+ *      - A cell of the asynchronous queue, when ULOG_ENABLE_ASYNC_MODE is set
+ *      - The sink's own buffer, when exactly one registered sink accepts the
+ *        level and it supports SinkInterface::reserve() (e.g. FileSink)
+ *      - A scratch buffer, delivered to the sinks like uLog::log() on commit
+ *
+ *    Whatever holds the space is tied up until commit(): the sink lock, or a
+ *    queue cell the drain thread can't get past. Keep reservations short and
+ *    don't log to the same sink before committing. Removing the sink waits
+ *    for the commit, and registry changes on the reserving thread are refused
+ *    until then. Coalescing doesn't apply to reserved messages.
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_RESERVATION_HPP
+#define MICRO_LOGGER_RESERVATION_HPP
+
+/* C++ Includes */
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+/* uLog Includes */
+#include <uLog/config.hpp>
+#include <uLog/record.hpp>
+#include <uLog/scratch.hpp>
+#include <uLog/types.hpp>
+
+namespace uLog
+{
+  /**
+   *  RAII claim on the space for one message. Always check valid() before use:
+   *  the level may be filtered out, or no buffer may be able to hold maxBytes.
+   *  Destroying an uncommitted reservation throws the message away.
+   */
+  class Reservation
+  {
+  public:
+    /**
+     *  Claims space for a message from DefaultModule
+     *
+     *  @param[in]  level     The severity level of the message
+     *  @param[in]  maxBytes  Most bytes the message will need
+     */
+    Reservation( const Level level, const size_t maxBytes );
+
+    /**
+     *  Claims space for a message from a module
+     *
+     *  @param[in]  module    The module the message comes from
+     *  @param[in]  level     The severity level of the message
+     *  @param[in]  maxBytes  Most bytes the message will need
+     */
+    Reservation( const ModuleId module, const Level level, const size_t maxBytes );
+
+    ~Reservation();
+
+    Reservation( const Reservation & ) = delete;
+    Reservation &operator=( const Reservation & ) = delete;
+
+    /**
+     *  Checks if space was successfully claimed
+     *  @return bool
+     */
+    bool valid() const
+    {
+      return mData != nullptr;
+    }
+
+    /**
+     *  Gets the start of the claimed space
+     *  @return void *
+     */
+    void *data() const
+    {
+      return mData;
+    }
+
+    /**
+     *  Gets how many bytes may be written, which is the maxBytes asked for
+     *  @return size_t
+     */
+    size_t size() const
+    {
+      return mSize;
+    }
+
+    /**
+     *  Hands the message on for delivery. Only the first 'length' bytes are
+     *  kept; the reservation is spent either way.
+     *
+     *  @param[in]  length    Bytes actually written, at most size()
+     *  @return Result
+     */
+    Result commit( const size_t length );
+
+  private:
+    /**
+     *  Where the claimed space lives
+     */
+    enum class Target : uint8_t
+    {
+      NONE,
+      QUEUE,
+      SINK,
+      SCRATCH
+    };
+
+    Target mTarget;
+    RecordInfo mInfo;
+    uint8_t *mData;
+    size_t mSize;
+    size_t mTicket;                        /**< Queue cell holding the space */
+    void *mEntry;                          /**< Queue entry holding the space */
+    void *mQueue;                          /**< Per thread queue the entry belongs to */
+    SinkInterface *mSink;                  /**< Sink lending its buffer */
+    std::optional<ScratchBuffer> mScratch; /**< Fallback space */
+
+    Result release( const size_t length );
+  };
+}    // namespace uLog
+
+#endif /* !MICRO_LOGGER_RESERVATION_HPP */
@@ -0,0 +1,87 @@
+/********************************************************************************
+ *  File Name:
+ *    scratch.cpp
+ *
+ *  Description:
+ *    Scratch buffer allocation
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* C++ Includes */
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+/* uLog Includes */
+#include <uLog/scratch.hpp>
+
+namespace uLog
+{
+  static_assert( ( ULOG_SCRATCH_POOL_SIZE > 0 ) && ( ULOG_SCRATCH_POOL_SIZE <= 32 ), "Invalid scratch pool size" );
+
+  static constexpr size_t ThreadSlot = std::numeric_limits<size_t>::max();
+  static constexpr uint32_t AllFree  = ( ULOG_SCRATCH_POOL_SIZE == 32 ) ? 0xFFFFFFFFu : ( ( 1u << ULOG_SCRATCH_POOL_SIZE ) - 1u );
+
+  static std::array<std::array<char, ULOG_MAX_SNPRINTF_BUFFER_LENGTH>, ULOG_SCRATCH_POOL_SIZE> scratchPool;
+  static std::atomic<uint32_t> scratchFreeMask( AllFree );
+
+#if ( ULOG_SCRATCH_USE_THREAD_LOCAL == 1 )
+  static thread_local std::array<char, ULOG_MAX_SNPRINTF_BUFFER_LENGTH> threadScratch;
+  static thread_local bool threadScratchBusy = false;
+#endif
+
+  ScratchBuffer::ScratchBuffer() : mBuffer( nullptr ), mSlot( 0 )
+  {
+#if ( ULOG_SCRATCH_USE_THREAD_LOCAL == 1 )
+    /*------------------------------------------------
+    Fast path: this thread's own buffer, unless a sink
+    re-entered the logger while it was being used.
+    ------------------------------------------------*/
+    if ( !threadScratchBusy )
+    {
+      threadScratchBusy = true;
+      mBuffer           = threadScratch.data();
+      mSlot             = ThreadSlot;
+      return;
+    }
+#endif
+
+    /*------------------------------------------------
+    Claim the lowest free buffer in the shared pool
+    ------------------------------------------------*/
+    uint32_t mask = scratchFreeMask.load( std::memory_order_relaxed );
+
+    while ( mask )
+    {
+      const uint32_t slot = static_cast<uint32_t>( __builtin_ctz( mask ) );
+
+      if ( scratchFreeMask.compare_exchange_weak( mask, mask & ~( 1u << slot ), std::memory_order_acquire,
+                                                  std::memory_order_relaxed ) )
+      {
+        mBuffer = scratchPool[ slot ].data();
+        mSlot   = slot;
+        break;
+      }
+    }
+  }
+
+  ScratchBuffer::~ScratchBuffer()
+  {
+    if ( !mBuffer )
+    {
+      return;
+    }
+
+#if ( ULOG_SCRATCH_USE_THREAD_LOCAL == 1 )
+    if ( mSlot == ThreadSlot )
+    {
+      threadScratchBusy = false;
+      return;
+    }
+#endif
+
+    scratchFreeMask.fetch_or( 1u << mSlot, std::memory_order_release );
+  }
+}    // namespace uLog
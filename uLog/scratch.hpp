@@ -0,0 +1,70 @@
+/********************************************************************************
+ *  File Name:
+ *    scratch.hpp
+ *
+ *  Description:
+ *    Scratch buffers used to format messages outside of any sink lock
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_SCRATCH_HPP
+#define MICRO_LOGGER_SCRATCH_HPP
+
+/* C++ Includes */
+#include <cstddef>
+
+/* uLog Includes */
+#include <uLog/config.hpp>
+
+namespace uLog
+{
+  /**
+   *  RAII claim on a formatting buffer of ULOG_MAX_SNPRINTF_BUFFER_LENGTH bytes.
+   *  Prefers the calling thread's own buffer and falls back to the shared pool.
+   *  Always check valid() before use: the pool can be exhausted.
+   */
+  class ScratchBuffer
+  {
+  public:
+    ScratchBuffer();
+    ~ScratchBuffer();
+
+    ScratchBuffer( const ScratchBuffer & ) = delete;
+    ScratchBuffer &operator=( const ScratchBuffer & ) = delete;
+
+    /**
+     *  Checks if a buffer was successfully claimed
+     *  @return bool
+     */
+    bool valid() const
+    {
+      return mBuffer != nullptr;
+    }
+
+    /**
+     *  Gets the start of the claimed buffer
+     *  @return char *
+     */
+    char *data() const
+    {
+      return mBuffer;
+    }
+
+    /**
+     *  Gets the size of the claimed buffer in bytes
+     *  @return size_t
+     */
+    static constexpr size_t size()
+    {
+      return ULOG_MAX_SNPRINTF_BUFFER_LENGTH;
+    }
+
+  private:
+    char *mBuffer;
+    size_t mSlot;
+  };
+}    // namespace uLog
+
+#endif /* !MICRO_LOGGER_SCRATCH_HPP */
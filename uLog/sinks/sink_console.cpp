@@ -0,0 +1,166 @@
+/********************************************************************************
+ *  File Name:
+ *    sink_console.cpp
+ *
+ *  Description:
+ *    Implementation of the POSIX console sink
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* uLog Includes */
+#include <uLog/sinks/sink_console.hpp>
+
+#if defined( MICRO_LOGGER_HAS_CONSOLE_SINK ) && ( MICRO_LOGGER_HAS_CONSOLE_SINK == 1 )
+
+/* C++ Includes */
+#include <cerrno>
+#include <cstring>
+
+namespace uLog
+{
+  ConsoleSink::ConsoleSink( const int fd, const BufferPolicy policy ) :
+      mFd( fd ), mRequestedPolicy( policy ), mPolicy( policy ), mUsed( 0 )
+  {
+  }
+
+  ConsoleSink::~ConsoleSink()
+  {
+    drain();
+  }
+
+  Result ConsoleSink::open()
+  {
+    mPolicy = mRequestedPolicy;
+
+    if ( mPolicy == BufferPolicy::AUTO )
+    {
+      mPolicy = isatty( mFd ) ? BufferPolicy::LINE : BufferPolicy::BATCH;
+    }
+
+    return Result::RESULT_SUCCESS;
+  }
+
+  Result ConsoleSink::close()
+  {
+    return flush();
+  }
+
+  Result ConsoleSink::flush()
+  {
+    this->lock();
+    auto result = drain();
+    this->unlock();
+
+    return result;
+  }
+
+  IOType ConsoleSink::getIOType()
+  {
+    return IOType::CONSOLE_SINK;
+  }
+
+  Result ConsoleSink::log( const Level level, const void *const message, const size_t length )
+  {
+    /*------------------------------------------------
+    Check to see if we should even write
+    ------------------------------------------------*/
+    if ( !isEnabled() || ( level < getLogLevel() ) || !message || !length )
+    {
+      return Result::RESULT_FAIL;
+    }
+
+    this->lock();
+
+    auto result     = Result::RESULT_SUCCESS;
+    const char *msg = static_cast<const char *>( message );
+
+    /*------------------------------------------------
+    Make room, then either buffer the message or, if it
+    is bigger than the whole buffer, send it directly.
+    ------------------------------------------------*/
+    if ( ( mBuffer.size() - mUsed ) < length )
+    {
+      result = drain();
+    }
+
+    if ( length > mBuffer.size() )
+    {
+      if ( !writeAll( msg, length ) )
+      {
+        result = Result::RESULT_FAIL;
+      }
+    }
+    else
+    {
+      memcpy( mBuffer.data() + mUsed, msg, length );
+      mUsed += length;
+
+      const bool urgent  = ( level >= Level::LVL_ERROR );
+      const bool newLine = ( mPolicy == BufferPolicy::LINE ) && memchr( msg, '\n', length );
+
+      if ( urgent || newLine )
+      {
+        result = drain();
+      }
+    }
+
+    this->unlock();
+    return result;
+  }
+
+  bool ConsoleSink::panicLog( const Level level, const Tick tick, const void *const message, const size_t length )
+  {
+    ( void )tick;
+
+    if ( !isEnabled() || ( level < getLogLevel() ) || !message || !length )
+    {
+      return false;
+    }
+
+    return writeAll( static_cast<const char *>( message ), length );
+  }
+
+  void ConsoleSink::panicFlush()
+  {
+    drain();
+  }
+
+  Result ConsoleSink::drain()
+  {
+    if ( !mUsed )
+    {
+      return Result::RESULT_SUCCESS;
+    }
+
+    const bool written = writeAll( mBuffer.data(), mUsed );
+    mUsed              = 0;
+
+    return written ? Result::RESULT_SUCCESS : Result::RESULT_FAIL;
+  }
+
+  bool ConsoleSink::writeAll( const char *data, size_t length )
+  {
+    while ( length )
+    {
+      const ssize_t written = ::write( mFd, data, length );
+
+      if ( written < 0 )
+      {
+        if ( errno == EINTR )
+        {
+          continue;
+        }
+
+        return false;
+      }
+
+      data += written;
+      length -= static_cast<size_t>( written );
+    }
+
+    return true;
+  }
+}    // namespace uLog
+
+#endif /* MICRO_LOGGER_HAS_CONSOLE_SINK */
@@ -0,0 +1,72 @@
+/********************************************************************************
+ *  File Name:
+ *    sink_console.hpp
+ *
+ *  Description:
+ *    POSIX console sink that writes straight to a file descriptor (stdout or
+ *    stderr) out of a fixed buffer, with no allocation or iostream overhead.
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_SINK_CONSOLE_HPP
+#define MICRO_LOGGER_SINK_CONSOLE_HPP
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#define MICRO_LOGGER_HAS_CONSOLE_SINK ( 1 )
+
+/* C++ Includes */
+#include <array>
+#include <cstdlib>
+
+/* POSIX Includes */
+#include <unistd.h>
+
+/* uLog Includes */
+#include <uLog/config.hpp>
+#include <uLog/sinks/sink_intf.hpp>
+#include <uLog/types.hpp>
+
+namespace uLog
+{
+  class ConsoleSink : public SinkInterface
+  {
+  public:
+    /**
+     *  When buffered output is pushed to the descriptor. ERROR and FATAL
+     *  messages are always written out immediately regardless of policy.
+     */
+    enum class BufferPolicy : uint8_t
+    {
+      AUTO, /**< LINE if the descriptor is a terminal, otherwise BATCH */
+      LINE, /**< Write out whenever a message contains a newline */
+      BATCH /**< Write out only when the buffer fills or on flush() */
+    };
+
+    ConsoleSink( const int fd = STDOUT_FILENO, const BufferPolicy policy = BufferPolicy::AUTO );
+    ~ConsoleSink();
+
+    Result open() final override;
+    Result close() final override;
+    Result flush() final override;
+    IOType getIOType() final override;
+    Result log( const Level level, const void *const message, const size_t length ) final override;
+    bool panicLog( const Level level, const Tick tick, const void *const message, const size_t length ) final override;
+    void panicFlush() final override;
+
+  private:
+    const int mFd;
+    const BufferPolicy mRequestedPolicy;
+    BufferPolicy mPolicy;
+    size_t mUsed;
+    std::array<char, ULOG_CONSOLE_SINK_BUFFER_SIZE> mBuffer;
+
+    Result drain();
+    bool writeAll( const char *data, size_t length );
+  };
+}    // namespace uLog
+
+#endif /* __unix__ || __APPLE__ */
+
+#endif /* !MICRO_LOGGER_SINK_CONSOLE_HPP */
@@ -12,7 +12,6 @@
 
 /* C++ Includes */
 #include <iostream>
-#include <string>
 
 /* uLog Includes */
 #include <uLog/sinks/sink_cout.hpp>
@@ -59,11 +58,16 @@ namespace uLog
     }
 
     /*------------------------------------------------
-    Simply assign the data as a string, then write it.
+    Write straight from the caller's memory. Let the stream
+    do its own buffering, except for messages that must be
+    seen right away.
     ------------------------------------------------*/
-    std::string coutBuffer;
-    coutBuffer.assign( reinterpret_cast<const char *const>( message ), length );
-    std::cout << coutBuffer << std::flush;
+    std::cout.write( reinterpret_cast<const char *const>( message ), length );
+
+    if ( level >= Level::LVL_ERROR )
+    {
+      std::cout.flush();
+    }
 
     return Result::RESULT_SUCCESS;
   }
@@ -0,0 +1,753 @@
+/********************************************************************************
+ *  File Name:
+ *    sink_file.cpp
+ *
+ *  Description:
+ *    Implementation of the POSIX file sink
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* uLog Includes */
+#include <uLog/sinks/sink_file.hpp>
+
+#if defined( MICRO_LOGGER_HAS_FILE_SINK ) && ( MICRO_LOGGER_HAS_FILE_SINK == 1 )
+
+/* C++ Includes */
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+/* POSIX Includes */
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace uLog
+{
+  FileSink::FileSink( const std::string &path ) : FileSink( path, Options() )
+  {
+  }
+
+  FileSink::FileSink( const std::string &path, const Options &options ) :
+      mPath( path ), mOptions( options ), mFd( -1 ), mFileSize( 0 ), mWriteError( 0 ), mWriteFailures( 0 ), mQueueOrder( 0 ),
+      mRetiredOrder( 0 ), mDiscardedOrder( 0 ), mActive( NoBuffer ), mInFlight( 0 ), mStopRequested( false ), mReserved( false )
+  {
+  }
+
+  FileSink::~FileSink()
+  {
+    close();
+  }
+
+  Result FileSink::open()
+  {
+    if ( mWriter.joinable() )
+    {
+      return Result::RESULT_SUCCESS;
+    }
+    else if ( ( mOptions.bufferCount < 2 ) || !mOptions.bufferSize )
+    {
+      return Result::RESULT_FAIL;
+    }
+
+    mFd = openFile( mPath, false );
+    if ( mFd < 0 )
+    {
+      return Result::RESULT_FAIL;
+    }
+
+    struct stat info;
+    mFileSize = ( fstat( mFd, &info ) == 0 ) ? static_cast<size_t>( info.st_size ) : 0;
+
+    /*------------------------------------------------
+    All memory is allocated up front so the log path
+    never touches the heap.
+    ------------------------------------------------*/
+    mBuffers = std::vector<Buffer>( mOptions.bufferCount );
+    mFree.clear();
+    mPending.clear();
+    mFree.reserve( mOptions.bufferCount );
+    mPending.reserve( mOptions.bufferCount );
+    mIoVectors.resize( mOptions.bufferCount );
+
+    for ( size_t i = 0; i < mBuffers.size(); i++ )
+    {
+      mBuffers[ i ].data.reset( new char[ mOptions.bufferSize ] );
+      resetBuffer( mBuffers[ i ] );
+      mFree.push_back( i );
+    }
+
+    mFrames.clear();
+    mCompressor.reset();
+
+    if ( mOptions.compress )
+    {
+      mCompressor = std::make_unique<Compress::BlockCompressor>();
+      mFrames.resize( mOptions.bufferCount );
+
+      for ( auto &frame : mFrames )
+      {
+        frame.reset( new uint8_t[ Compress::maxFrameSize( mOptions.bufferSize ) ] );
+      }
+    }
+
+    mQueueOrder     = 0;
+    mRetiredOrder   = 0;
+    mDiscardedOrder = 0;
+    mActive         = NoBuffer;
+    mInFlight       = 0;
+    mStopRequested  = false;
+    mReserved       = false;
+    mWriter         = std::thread( &FileSink::writerThread, this );
+
+    return Result::RESULT_SUCCESS;
+  }
+
+  Result FileSink::close()
+  {
+    if ( !mWriter.joinable() )
+    {
+      return Result::RESULT_SUCCESS;
+    }
+
+    /*------------------------------------------------
+    The writer drains everything before it exits
+    ------------------------------------------------*/
+    {
+      std::lock_guard<std::mutex> lock( mMutex );
+      mStopRequested = true;
+    }
+
+    mWorkSignal.notify_one();
+    mWriter.join();
+
+    if ( mFd >= 0 )
+    {
+      ::close( mFd );
+      mFd = -1;
+    }
+
+    return Result::RESULT_SUCCESS;
+  }
+
+  Result FileSink::flush()
+  {
+    if ( !mWriter.joinable() )
+    {
+      return Result::RESULT_FAIL;
+    }
+
+    /*------------------------------------------------
+    Only wait for what was logged before the call. Data
+    arriving afterwards would otherwise keep the writer
+    busy and this waiting forever.
+    ------------------------------------------------*/
+    std::unique_lock<std::mutex> lock( mMutex );
+
+    if ( ( mActive != NoBuffer ) && mBuffers[ mActive ].used && !mReserved )
+    {
+      queueBuffer( mActive );
+      mActive = NoBuffer;
+    }
+
+    const size_t target   = mQueueOrder;
+    const size_t failures = mWriteFailures.load( std::memory_order_relaxed );
+
+    mWorkSignal.notify_one();
+    mIdleSignal.wait( lock, [ this, target ] { return mRetiredOrder >= target; } );
+
+    return ( mWriteFailures.load( std::memory_order_relaxed ) == failures ) ? Result::RESULT_SUCCESS : Result::RESULT_FAIL;
+  }
+
+  IOType FileSink::getIOType()
+  {
+    return IOType::FILE_SINK;
+  }
+
+  int FileSink::getWriteError() const
+  {
+    return mWriteError.load( std::memory_order_relaxed );
+  }
+
+  Result FileSink::log( const Level level, const void *const message, const size_t length )
+  {
+    /*------------------------------------------------
+    Check to see if we should even write
+    ------------------------------------------------*/
+    if ( !isEnabled() || ( level < getLogLevel() ) || !message || !length || ( mFd < 0 ) )
+    {
+      return Result::RESULT_FAIL;
+    }
+
+    /*------------------------------------------------
+    Copy into the active buffer. A message that doesn't
+    fit in what's left starts a new buffer, so buffers
+    hold whole messages and DROP_OLDEST can throw one
+    away cleanly. Only messages larger than a buffer
+    span several, and those get a run of buffers to
+    themselves so they are discarded whole too. Full
+    buffers go straight to the writer.
+    ------------------------------------------------*/
+    const char *src  = static_cast<const char *>( message );
+    size_t remaining = length;
+    bool wakeWriter  = false;
+
+    std::unique_lock<std::mutex> lock( mMutex );
+
+    if ( mReserved )
+    {
+      return Result::RESULT_LOCKED;
+    }
+    else if ( ( mActive != NoBuffer ) && mBuffers[ mActive ].used &&
+              ( length > ( mOptions.bufferSize - mBuffers[ mActive ].used ) ) )
+    {
+      queueBuffer( mActive );
+      mActive    = NoBuffer;
+      wakeWriter = true;
+    }
+
+    while ( remaining )
+    {
+      if ( mActive == NoBuffer )
+      {
+        if ( wakeWriter )
+        {
+          mWorkSignal.notify_one();
+        }
+
+        mSpaceSignal.wait( lock, [ this ] { return !mFree.empty(); } );
+        mActive = mFree.back();
+        mFree.pop_back();
+        mBuffers[ mActive ].continuation = ( remaining != length );
+      }
+
+      Buffer &buffer     = mBuffers[ mActive ];
+      const size_t chunk = std::min( remaining, mOptions.bufferSize - buffer.used );
+
+      if ( remaining == length )
+      {
+        buffer.messages[ static_cast<size_t>( level ) ]++;
+      }
+
+      memcpy( buffer.data.get() + buffer.used, src, chunk );
+      buffer.used += chunk;
+      src += chunk;
+      remaining -= chunk;
+
+      if ( buffer.used == mOptions.bufferSize )
+      {
+        queueBuffer( mActive );
+        mActive    = NoBuffer;
+        wakeWriter = true;
+      }
+    }
+
+    if ( ( length > mOptions.bufferSize ) && ( mActive != NoBuffer ) )
+    {
+      queueBuffer( mActive );
+      mActive    = NoBuffer;
+      wakeWriter = true;
+    }
+
+    lock.unlock();
+
+    if ( wakeWriter )
+    {
+      mWorkSignal.notify_one();
+    }
+
+    return Result::RESULT_SUCCESS;
+  }
+
+  bool FileSink::waitForSpace( const size_t length, const size_t timeout )
+  {
+    if ( !mWriter.joinable() )
+    {
+      return true;
+    }
+
+    std::unique_lock<std::mutex> lock( mMutex );
+    auto room = [ this, length ] { return hasRoom( length ); };
+
+    if ( room() )
+    {
+      return true;
+    }
+    else if ( !timeout )
+    {
+      return false;
+    }
+    else if ( timeout == WaitForever )
+    {
+      mSpaceSignal.wait( lock, room );
+      return true;
+    }
+
+    return mSpaceSignal.wait_for( lock, std::chrono::milliseconds( timeout ), room );
+  }
+
+  bool FileSink::discardOldest( const size_t length )
+  {
+    std::lock_guard<std::mutex> lock( mMutex );
+
+    /*------------------------------------------------
+    Only buffers the writer hasn't picked up yet can go.
+    Each one takes its message counts with it, and the
+    rest of a message spanning into later buffers. The
+    tail of one the writer has already started on has
+    to stay, so nothing past it can go either.
+    ------------------------------------------------*/
+    while ( !hasRoom( length ) && !mPending.empty() && !mBuffers[ mPending.front() ].continuation )
+    {
+      do
+      {
+        Buffer &buffer = mBuffers[ mPending.front() ];
+
+        countBufferDrops( buffer );
+        mDiscardedOrder = buffer.queuedAt.load( std::memory_order_relaxed );
+        resetBuffer( buffer );
+        mFree.push_back( mPending.front() );
+        mPending.erase( mPending.begin() );
+      } while ( !mPending.empty() && mBuffers[ mPending.front() ].continuation );
+    }
+
+    /*------------------------------------------------
+    Older buffers still being written keep flush()
+    waiting until the writer is done with them
+    ------------------------------------------------*/
+    if ( !mInFlight && ( mDiscardedOrder > mRetiredOrder ) )
+    {
+      mRetiredOrder = mDiscardedOrder;
+      mIdleSignal.notify_all();
+    }
+
+    return hasRoom( length );
+  }
+
+  void *FileSink::reserve( const size_t length )
+  {
+    if ( !isEnabled() || !length || ( length > mOptions.bufferSize ) || ( mFd < 0 ) )
+    {
+      return nullptr;
+    }
+
+    /*------------------------------------------------
+    Lend out the tail of the active buffer, starting a
+    fresh one if the claim doesn't fit in what's left.
+    The writer leaves the active buffer alone until the
+    claim is committed.
+    ------------------------------------------------*/
+    std::unique_lock<std::mutex> lock( mMutex );
+
+    if ( mReserved )
+    {
+      return nullptr;
+    }
+    else if ( ( mActive != NoBuffer ) && ( length > ( mOptions.bufferSize - mBuffers[ mActive ].used ) ) )
+    {
+      queueBuffer( mActive );
+      mActive = NoBuffer;
+      mWorkSignal.notify_one();
+    }
+
+    if ( mActive == NoBuffer )
+    {
+      mSpaceSignal.wait( lock, [ this ] { return !mFree.empty(); } );
+      mActive = mFree.back();
+      mFree.pop_back();
+    }
+
+    mReserved = true;
+    return mBuffers[ mActive ].data.get() + mBuffers[ mActive ].used;
+  }
+
+  Result FileSink::commit( const Level level, const size_t length )
+  {
+    std::unique_lock<std::mutex> lock( mMutex );
+
+    if ( !mReserved || ( mActive == NoBuffer ) || ( length > ( mOptions.bufferSize - mBuffers[ mActive ].used ) ) )
+    {
+      mReserved = false;
+      return Result::RESULT_FAIL;
+    }
+
+    Buffer &buffer  = mBuffers[ mActive ];
+    bool wakeWriter = false;
+
+    mReserved = false;
+
+    if ( length )
+    {
+      buffer.used += length;
+      buffer.messages[ static_cast<size_t>( level ) ]++;
+    }
+
+    if ( buffer.used == mOptions.bufferSize )
+    {
+      queueBuffer( mActive );
+      mActive    = NoBuffer;
+      wakeWriter = true;
+    }
+
+    lock.unlock();
+
+    if ( wakeWriter )
+    {
+      mWorkSignal.notify_one();
+    }
+
+    return Result::RESULT_SUCCESS;
+  }
+
+  bool FileSink::panicLog( const Level level, const Tick tick, const void *const message, const size_t length )
+  {
+    ( void )tick;
+
+    if ( !isEnabled() || ( level < getLogLevel() ) || !message || !length )
+    {
+      return false;
+    }
+
+    return panicWrite( message, length );
+  }
+
+  void FileSink::panicFlush()
+  {
+    /*------------------------------------------------
+    Oldest first: buffers queued for the writer, then
+    the one being filled. A batch the writer already
+    took is its own to finish.
+
+    mPending may be mid-update on another thread, so the
+    queued buffers are found through their own stamps
+    instead, picking the next oldest on each pass.
+    ------------------------------------------------*/
+    size_t written = 0;
+
+    while ( true )
+    {
+      size_t next  = NoBuffer;
+      size_t order = 0;
+
+      for ( size_t i = 0; i < mBuffers.size(); i++ )
+      {
+        const size_t queuedAt = mBuffers[ i ].queuedAt.load( std::memory_order_acquire );
+
+        if ( ( queuedAt > written ) && ( ( next == NoBuffer ) || ( queuedAt < order ) ) )
+        {
+          next  = i;
+          order = queuedAt;
+        }
+      }
+
+      if ( next == NoBuffer )
+      {
+        break;
+      }
+
+      panicWrite( mBuffers[ next ].data.get(), mBuffers[ next ].used );
+      written = order;
+    }
+
+    if ( ( mActive != NoBuffer ) && !mReserved )
+    {
+      panicWrite( mBuffers[ mActive ].data.get(), mBuffers[ mActive ].used );
+    }
+  }
+
+  bool FileSink::panicWrite( const void *const data, const size_t length )
+  {
+    const int fd = mFd.load();
+
+    if ( ( fd < 0 ) || !length )
+    {
+      return false;
+    }
+
+    /*------------------------------------------------
+    The compressor belongs to the writer thread, so a
+    compressed file gets a stored frame instead.
+    ------------------------------------------------*/
+    uint8_t header[ Compress::FrameHeaderSize ];
+    const uint32_t fields[ 3 ] = { Compress::FrameMagic, static_cast<uint32_t>( length ),
+                                   static_cast<uint32_t>( length ) | Compress::FrameStoredFlag };
+
+    for ( size_t i = 0; i < Compress::FrameHeaderSize; i++ )
+    {
+      header[ i ] = static_cast<uint8_t>( fields[ i / 4 ] >> ( 8 * ( i % 4 ) ) );
+    }
+
+    const uint8_t *chunks[ 2 ] = { header, static_cast<const uint8_t *>( data ) };
+    size_t sizes[ 2 ]          = { mCompressor ? sizeof( header ) : 0, length };
+
+    for ( size_t i = 0; i < 2; i++ )
+    {
+      while ( sizes[ i ] )
+      {
+        const ssize_t written = ::write( fd, chunks[ i ], sizes[ i ] );
+
+        if ( written < 0 )
+        {
+          if ( errno == EINTR )
+          {
+            continue;
+          }
+
+          return false;
+        }
+
+        chunks[ i ] += written;
+        sizes[ i ] -= static_cast<size_t>( written );
+      }
+    }
+
+    return true;
+  }
+
+  bool FileSink::hasRoom( const size_t length ) const
+  {
+    const size_t activeRoom = ( mActive != NoBuffer ) ? ( mOptions.bufferSize - mBuffers[ mActive ].used ) : 0;
+
+    /*------------------------------------------------
+    Small messages need the rest of the active buffer or
+    a fresh one. Larger ones need whole buffers, up to
+    the most the sink could ever have.
+    ------------------------------------------------*/
+    if ( length <= mOptions.bufferSize )
+    {
+      return ( length <= activeRoom ) || !mFree.empty();
+    }
+
+    const size_t capacity = mOptions.bufferSize * mOptions.bufferCount;
+    const size_t empty    = mFree.size() + ( ( activeRoom == mOptions.bufferSize ) ? 1 : 0 );
+    return ( empty * mOptions.bufferSize ) >= std::min( length, capacity );
+  }
+
+  void FileSink::countBufferDrops( const Buffer &buffer )
+  {
+    for ( size_t level = 0; level < LevelCount; level++ )
+    {
+      if ( buffer.messages[ level ] )
+      {
+        countDrops( static_cast<Level>( level ), buffer.messages[ level ] );
+      }
+    }
+  }
+
+  void FileSink::resetBuffer( Buffer &buffer )
+  {
+    buffer.used         = 0;
+    buffer.continuation = false;
+    buffer.messages.fill( 0 );
+    buffer.queuedAt.store( 0, std::memory_order_release );
+  }
+
+  void FileSink::queueBuffer( const size_t index )
+  {
+    mPending.push_back( index );
+    mBuffers[ index ].queuedAt.store( ++mQueueOrder, std::memory_order_release );
+  }
+
+  void FileSink::writerThread()
+  {
+    std::vector<size_t> batch;
+    batch.reserve( mOptions.bufferCount );
+
+    std::unique_lock<std::mutex> lock( mMutex );
+
+    while ( true )
+    {
+      mWorkSignal.wait_for( lock, std::chrono::milliseconds( mOptions.flushIntervalMs ),
+                            [ this ] { return !mPending.empty() || mStopRequested; } );
+
+      /*------------------------------------------------
+      A partially filled buffer goes out on the interval
+      timer. flush() queues its own.
+      ------------------------------------------------*/
+      if ( ( mActive != NoBuffer ) && mBuffers[ mActive ].used && mPending.empty() && !mReserved )
+      {
+        queueBuffer( mActive );
+        mActive = NoBuffer;
+      }
+
+      if ( mPending.empty() )
+      {
+        if ( mStopRequested )
+        {
+          break;
+        }
+
+        continue;
+      }
+
+      /*------------------------------------------------
+      Do the I/O without holding the lock so producers can
+      keep filling the remaining free buffers.
+      ------------------------------------------------*/
+      batch.swap( mPending );
+      mInFlight = batch.size();
+
+      const size_t batchOrder = mBuffers[ batch.back() ].queuedAt.load( std::memory_order_relaxed );
+
+      for ( size_t index : batch )
+      {
+        mBuffers[ index ].queuedAt.store( 0, std::memory_order_release );
+      }
+
+      lock.unlock();
+
+      writeBatch( batch );
+
+      if ( mOptions.rotateSize && ( mFileSize >= mOptions.rotateSize ) )
+      {
+        rotate();
+      }
+
+      lock.lock();
+
+      for ( size_t index : batch )
+      {
+        resetBuffer( mBuffers[ index ] );
+        mFree.push_back( index );
+      }
+
+      batch.clear();
+      mInFlight     = 0;
+      mRetiredOrder = std::max( { mRetiredOrder, batchOrder, mDiscardedOrder } );
+      mSpaceSignal.notify_all();
+      mIdleSignal.notify_all();
+    }
+  }
+
+  void FileSink::writeBatch( const std::vector<size_t> &batch )
+  {
+    std::vector<struct iovec> &iov = mIoVectors;
+    size_t count                   = 0;
+
+    for ( size_t index : batch )
+    {
+      iov[ count ].iov_base = mBuffers[ index ].data.get();
+      iov[ count ].iov_len  = mBuffers[ index ].used;
+
+      /*------------------------------------------------
+      Each buffer becomes one self contained frame, so a
+      cut off file decodes up to the last whole buffer.
+      ------------------------------------------------*/
+      if ( mCompressor )
+      {
+        uint8_t *const frame = mFrames[ count ].get();
+
+        iov[ count ].iov_len  = mCompressor->encodeFrame( mBuffers[ index ].data.get(), mBuffers[ index ].used, frame,
+                                                          Compress::maxFrameSize( mOptions.bufferSize ) );
+        iov[ count ].iov_base = frame;
+      }
+
+      count++;
+    }
+
+    /*------------------------------------------------
+    Keep going until the kernel has taken everything,
+    stepping past whatever a short write consumed.
+    ------------------------------------------------*/
+    struct iovec *next = iov.data();
+
+    while ( count )
+    {
+      const ssize_t written = writev( mFd, next, static_cast<int>( std::min<size_t>( count, IOV_MAX ) ) );
+
+      if ( written < 0 )
+      {
+        if ( errno == EINTR )
+        {
+          continue;
+        }
+
+        /*------------------------------------------------
+        Everything not yet fully written is lost, even a
+        buffer the kernel took part of
+        ------------------------------------------------*/
+        mWriteError.store( errno, std::memory_order_relaxed );
+        mWriteFailures.fetch_add( 1, std::memory_order_relaxed );
+
+        for ( size_t i = batch.size() - count; i < batch.size(); i++ )
+        {
+          countBufferDrops( mBuffers[ batch[ i ] ] );
+        }
+
+        break;
+      }
+
+      mFileSize += static_cast<size_t>( written );
+      size_t consumed = static_cast<size_t>( written );
+
+      while ( count && ( consumed >= next->iov_len ) )
+      {
+        consumed -= next->iov_len;
+        next++;
+        count--;
+      }
+
+      if ( count )
+      {
+        next->iov_base = static_cast<char *>( next->iov_base ) + consumed;
+        next->iov_len -= consumed;
+      }
+    }
+  }
+
+  void FileSink::rotate()
+  {
+    /*------------------------------------------------
+    Open the replacement before letting go of anything.
+    If that fails, keep writing to the current file and
+    try again after the next batch.
+    ------------------------------------------------*/
+    const std::string next = mOptions.rotateCount ? ( mPath + ".next" ) : mPath;
+    const int fd           = openFile( next, true );
+
+    if ( fd < 0 )
+    {
+      return;
+    }
+
+    /*------------------------------------------------
+    Shift path.N-1 -> path.N ... path -> path.1 and move
+    the new file into place, or just start over when no
+    history is kept.
+    ------------------------------------------------*/
+    if ( mOptions.rotateCount )
+    {
+      for ( size_t i = mOptions.rotateCount; i > 1; i-- )
+      {
+        const std::string from = mPath + "." + std::to_string( i - 1 );
+        const std::string to   = mPath + "." + std::to_string( i );
+        ::rename( from.c_str(), to.c_str() );
+      }
+
+      const std::string first = mPath + ".1";
+      ::rename( mPath.c_str(), first.c_str() );
+      ::rename( next.c_str(), mPath.c_str() );
+    }
+
+    /*------------------------------------------------
+    Swap before closing, so panicWrite(), which loads the
+    fd on its own, finds the new file and not a number
+    that is already closed and may be reused
+    ------------------------------------------------*/
+    ::close( mFd.exchange( fd ) );
+    mFileSize = 0;
+  }
+
+  int FileSink::openFile( const std::string &path, const bool truncate )
+  {
+    const int flags = O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | ( truncate ? O_TRUNC : 0 );
+    return ::open( path.c_str(), flags, 0644 );
+  }
+}    // namespace uLog
+
+#endif /* MICRO_LOGGER_HAS_FILE_SINK */
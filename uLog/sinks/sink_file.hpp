@@ -0,0 +1,145 @@
+/********************************************************************************
+ *  File Name:
+ *    sink_file.hpp
+ *
+ *  Description:
+ *    High throughput POSIX file sink. Messages are coalesced into large buffers
+ *    that a background writer thread pushes to disk with writev(). Files are
+ *    rotated by size on the writer thread so producers never wait on a rename.
+ *    Optionally, the writer compresses each buffer into a standalone frame
+ *    before it goes to disk, keeping the cost off the producer threads.
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_SINK_FILE_HPP
+#define MICRO_LOGGER_SINK_FILE_HPP
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#define MICRO_LOGGER_HAS_FILE_SINK ( 1 )
+
+/* C++ Includes */
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* POSIX Includes */
+#include <sys/uio.h>
+
+/* uLog Includes */
+#include <uLog/compress/lz_block.hpp>
+#include <uLog/config.hpp>
+#include <uLog/sinks/sink_intf.hpp>
+#include <uLog/types.hpp>
+
+namespace uLog
+{
+  class FileSink : public SinkInterface
+  {
+  public:
+    /**
+     *  Tuning knobs for the sink
+     */
+    struct Options
+    {
+      size_t bufferSize      = ULOG_FILE_SINK_BUFFER_SIZE;       /**< Bytes per coalescing buffer */
+      size_t bufferCount     = ULOG_FILE_SINK_BUFFER_COUNT;      /**< Number of buffers, at least 2 */
+      size_t flushIntervalMs = ULOG_FILE_SINK_FLUSH_INTERVAL_MS; /**< Longest time data waits in a partial buffer */
+      size_t rotateSize      = 0;                                /**< Rotate past this many bytes. 0 disables */
+      size_t rotateCount     = 0;                                /**< Rotated files kept as path.1 .. path.N */
+      bool compress          = false;                            /**< Write each buffer as a compressed frame */
+    };
+
+    FileSink( const std::string &path );
+    FileSink( const std::string &path, const Options &options );
+    ~FileSink();
+
+    Result open() final override;
+    Result close() final override;
+    Result flush() final override;
+    IOType getIOType() final override;
+
+    /**
+     *  Error from the most recent failed write to the file. Records in a batch
+     *  that failed are counted as drops, and the flush() that was waiting on
+     *  them returns RESULT_FAIL.
+     *
+     *  @return int           errno of the failure, or 0 if no write has failed
+     */
+    int getWriteError() const;
+
+    Result log( const Level level, const void *const message, const size_t length ) final override;
+    bool waitForSpace( const size_t length, const size_t timeout ) final override;
+    bool discardOldest( const size_t length ) final override;
+    void *reserve( const size_t length ) final override;
+    Result commit( const Level level, const size_t length ) final override;
+    bool panicLog( const Level level, const Tick tick, const void *const message, const size_t length ) final override;
+    void panicFlush() final override;
+
+  private:
+    struct Buffer
+    {
+      std::unique_ptr<char[]> data;
+      size_t used;
+      std::array<size_t, LevelCount> messages; /**< Messages that start in this buffer, per level */
+      std::atomic<size_t> queuedAt;            /**< When it was queued for the writer, 0 if it isn't */
+      bool continuation;                       /**< Holds the rest of a message begun in an earlier buffer */
+    };
+
+    static constexpr size_t NoBuffer = static_cast<size_t>( -1 );
+
+    const std::string mPath;
+    const Options mOptions;
+
+    std::atomic<int> mFd; /**< Swapped by the writer thread on rotation */
+    size_t mFileSize;     /**< Only touched by the writer thread while running */
+
+    std::atomic<int> mWriteError;       /**< errno of the last failed write */
+    std::atomic<size_t> mWriteFailures; /**< Batches lost to a failed write, ever */
+
+    /*-------------------------------------------------
+    Buffer bookkeeping, all guarded by mMutex
+    -------------------------------------------------*/
+    std::mutex mMutex;
+    std::condition_variable mWorkSignal;  /**< Wakes the writer */
+    std::condition_variable mSpaceSignal; /**< Wakes producers waiting on a free buffer */
+    std::condition_variable mIdleSignal;  /**< Wakes flush() callers */
+    std::vector<Buffer> mBuffers;
+    std::vector<size_t> mFree;
+    std::vector<size_t> mPending;
+    size_t mQueueOrder;     /**< Last Buffer::queuedAt handed out */
+    size_t mRetiredOrder;   /**< Buffers up to this Buffer::queuedAt are written out or discarded */
+    size_t mDiscardedOrder; /**< Last Buffer::queuedAt thrown away by discardOldest() */
+    size_t mActive;
+    size_t mInFlight;
+    bool mStopRequested;
+    bool mReserved; /**< The active buffer is lent out by reserve() */
+
+    std::thread mWriter;
+    std::vector<struct iovec> mIoVectors; /**< Writer thread scratch for writev() */
+
+    std::unique_ptr<Compress::BlockCompressor> mCompressor; /**< Only used by the writer thread */
+    std::vector<std::unique_ptr<uint8_t[]>> mFrames;        /**< Compressed output, one per batch entry */
+
+    bool hasRoom( const size_t length ) const;
+    void countBufferDrops( const Buffer &buffer );
+    void resetBuffer( Buffer &buffer );
+    void queueBuffer( const size_t index );
+    void writerThread();
+    void writeBatch( const std::vector<size_t> &batch );
+    void rotate();
+    int openFile( const std::string &path, const bool truncate );
+    bool panicWrite( const void *const data, const size_t length );
+  };
+}    // namespace uLog
+
+#endif /* __unix__ || __APPLE__ */
+
+#endif /* !MICRO_LOGGER_SINK_FILE_HPP */
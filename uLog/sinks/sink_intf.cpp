@@ -10,6 +10,7 @@
 
 /* include description */
 #include <uLog/sinks/sink_intf.hpp>
+#include <uLog/ulog.hpp>
 
 namespace uLog
 {
@@ -18,6 +19,28 @@ namespace uLog
     mSinkEnabled  = false;
     mLoggingLevel = Level::LVL_MAX;
     mName         = "";
-    mLogBuffer.fill( 0 );
+    mRecordFormat = RecordFormat::TEXT;
+    mSpillSink    = nullptr;
+
+    mBackpressure.fill( { Backpressure::BLOCK, WaitForever } );
+    resetDropCounts();
+  }
+
+  void SinkInterface::enable()
+  {
+    mSinkEnabled = true;
+    refreshSinkLevels();
+  }
+
+  void SinkInterface::disable()
+  {
+    mSinkEnabled = false;
+    refreshSinkLevels();
+  }
+
+  void SinkInterface::setLogLevel( const Level level )
+  {
+    mLoggingLevel = level;
+    refreshSinkLevels();
   }
 }  // namespace
@@ -13,7 +13,9 @@
 #define MICRO_LOGGER_SINK_INTERFACE_HPP
 
 /* C++ Includes */
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
@@ -24,7 +26,13 @@
 #include <Chimera/thread>
 
 /* uLog Includes */
+#include <uLog/coalesce.hpp>
 #include <uLog/config.hpp>
+#include <uLog/format.hpp>
+#include <uLog/metrics.hpp>
+#include <uLog/record.hpp>
+#include <uLog/scratch.hpp>
+#include <uLog/timestamp.hpp>
 #include <uLog/types.hpp>
 
 namespace uLog
@@ -57,21 +65,122 @@ namespace uLog
     virtual Result log( const Level level, const void *const message, const size_t length ) = 0;
 
     /**
-     *  Enables the sink so logs can be processed
+     *  Logs a message along with the tick captured when uLog::log() was called.
+     *  This is what the registry dispatches to. Sinks that want timestamps
+     *  override it; the default drops the tick and calls the plain overload.
+     *
+     *  @param[in]  level     The log level the message was sent at
+     *  @param[in]  tick      Raw tick from uLog::readTick()
+     *  @param[in]  message   The message to be logged. Can be any kind of data
+     *  @param[in]  length    How large the message is in bytes
+     *  @return ResultType    Whether or not the logging action succeeded
      */
-    void enable()
+    virtual Result log( const Level level, const Tick tick, const void *const message, const size_t length )
     {
-      mSinkEnabled = true;
+      ( void )tick;
+      return log( level, message, length );
     }
 
     /**
-     *  Disables the sink so logs cannot be processed
+     *  Waits until the sink can take 'length' more bytes without log() blocking.
+     *  Only called with the sink lock held. Sinks that never block on their own
+     *  buffers keep the default.
+     *
+     *  @param[in]  length    Bytes about to be logged
+     *  @param[in]  timeout   Milliseconds to wait, or WaitForever
+     *  @return bool          True if log() will not block
+     */
+    virtual bool waitForSpace( const size_t length, const size_t timeout )
+    {
+      ( void )length;
+      ( void )timeout;
+      return true;
+    }
+
+    /**
+     *  Throws away the oldest messages the sink is still holding until 'length'
+     *  bytes fit, reporting each one through countDrops(). Only called with the
+     *  sink lock held, for Backpressure::DROP_OLDEST.
+     *
+     *  @param[in]  length    Bytes about to be logged
+     *  @return bool          True if enough room was made
+     */
+    virtual bool discardOldest( const size_t length )
+    {
+      ( void )length;
+      return false;
+    }
+
+    /**
+     *  Emergency write used by uLog::panicFlush(), which may run inside a
+     *  signal handler. Must write straight through to the device using only
+     *  async-signal-safe operations and must not take any lock. Another thread
+     *  may be inside the sink at the time, so this is best effort.
+     *
+     *  @param[in]  level     The log level the message was sent at
+     *  @param[in]  tick      Raw tick from uLog::readTick()
+     *  @param[in]  message   The message to be logged
+     *  @param[in]  length    How large the message is in bytes
+     *  @return bool          False if the sink can't do this safely
      */
-    void disable()
+    virtual bool panicLog( const Level level, const Tick tick, const void *const message, const size_t length )
     {
-      mSinkEnabled = false;
+      ( void )level;
+      ( void )tick;
+      ( void )message;
+      ( void )length;
+      return false;
     }
 
+    /**
+     *  Emergency flush used by uLog::panicFlush(). Pushes out whatever the sink
+     *  is holding, under the same rules as panicLog().
+     */
+    virtual void panicFlush()
+    {
+    }
+
+    /**
+     *  Claims 'length' contiguous bytes inside the sink's own buffer for a
+     *  message to be written in place. Called with the sink lock held, which
+     *  stays held until the matching commit(). Sinks without a buffer to lend
+     *  keep the default and are written through log() instead.
+     *
+     *  @param[in]  length    Bytes to claim
+     *  @return void *        Start of the claimed bytes, or nullptr
+     */
+    virtual void *reserve( const size_t length )
+    {
+      ( void )length;
+      return nullptr;
+    }
+
+    /**
+     *  Finishes a reserve(), keeping the first 'length' bytes written. A length
+     *  of zero gives the whole claim back.
+     *
+     *  @param[in]  level     The log level the message was sent at
+     *  @param[in]  length    Bytes actually written
+     *  @return Result
+     */
+    virtual Result commit( const Level level, const size_t length )
+    {
+      ( void )level;
+      ( void )length;
+      return Result::RESULT_FAIL;
+    }
+
+    /**
+     *  Enables the sink so logs can be processed
+     */
+    void enable();
+
+    /**
+     *  Disables the sink so logs cannot be processed. Messages only this sink
+     *  would have taken are then filtered out before formatting.
+     */
+    void disable();
+
     /**
      *  Checks if the sink is enabled
      *  @return bool
@@ -85,13 +194,12 @@ namespace uLog
      *  Sets the minimum log level threshold. This level, plus any higher priority
      *  levels, will be logged with the sink.
      *
+     *  @note This also rebuilds the registry's cached dispatch filter
+     *
      *  @param[in]  level   The minimum log level for this sink
      *  @return ResultType
      */
-    void setLogLevel( const Level level )
-    {
-      mLoggingLevel = level;
-    }
+    void setLogLevel( const Level level );
 
     /**
      *  Gets the log level currently assigned to the sink
@@ -128,35 +236,234 @@ namespace uLog
     }
 
     /**
+     *  Selects whether log() receives bare payloads or binary framed records.
+     *  Set this before registering the sink: binary sinks are sent a
+     *  calibration record at registration so their ticks can be converted.
+     *
+     *  @param[in]  format    Format of the bytes handed to log()
+     */
+    void setRecordFormat( const RecordFormat format )
+    {
+      mRecordFormat = format;
+    }
+
+    /**
+     *  Gets the format of the bytes handed to log()
+     *
+     *  @return RecordFormat
+     */
+    RecordFormat getRecordFormat()
+    {
+      return mRecordFormat;
+    }
+
+    /**
+     *  Allows or prevents duplicate message coalescing on this sink. Has no
+     *  effect unless ULOG_ENABLE_COALESCING is set.
+     *
+     *  @param[in]  enabled   Whether repeats may be folded into a summary
+     */
+    void setCoalescing( const bool enabled )
+    {
+      mCoalescer.setEnabled( enabled );
+    }
+
+    /**
+     *  Duplicate tracking state used by the dispatch path
+     *
+     *  @warning  Only touch this while holding the sink lock
+     *  @return Coalescer &
+     */
+    Coalescer &getCoalescer()
+    {
+      return mCoalescer;
+    }
+
+    /**
+     *  Sets how every level handles an overloaded sink. Set this before
+     *  registering the sink. FATAL messages are never dropped: once their
+     *  policy gives up they wait on the sink for as long as it takes.
+     *
+     *  @param[in]  policy    Policy for all levels
+     */
+    void setBackpressure( const BackpressurePolicy &policy )
+    {
+      mBackpressure.fill( policy );
+    }
+
+    /**
+     *  Overrides how one level handles an overloaded sink
+     *
+     *  @param[in]  level     The level to change
+     *  @param[in]  policy    Policy for that level
+     *  @return Result        RESULT_INVALID_LEVEL if the level is out of range
+     */
+    Result setBackpressure( const Level level, const BackpressurePolicy &policy )
+    {
+      if ( level > Level::LVL_MAX )
+      {
+        return Result::RESULT_INVALID_LEVEL;
+      }
+
+      mBackpressure[ static_cast<size_t>( level ) ] = policy;
+      return Result::RESULT_SUCCESS;
+    }
+
+    /**
+     *  Gets the policy applied to a level when the sink is overloaded
+     *
+     *  @param[in]  level     The level to look up
+     *  @return BackpressurePolicy
+     */
+    BackpressurePolicy getBackpressure( const Level level )
+    {
+      return mBackpressure[ std::min( static_cast<size_t>( level ), LevelCount - 1 ) ];
+    }
+
+    /**
+     *  Sets where Backpressure::SPILL sends the messages this sink can't take.
+     *  The spill sink must already be open, e.g. by registering it too. Without
+     *  one, SPILL drops the message.
+     *
+     *  @param[in]  sink      The secondary sink, or nullptr
+     */
+    void setSpillSink( const SinkHandle &sink )
+    {
+      mSpillSink = sink;
+    }
+
+    /**
+     *  Gets the sink that takes this sink's overflow
+     *
+     *  @return SinkInterface *
+     */
+    SinkInterface *getSpillSink()
+    {
+      return sinkPointer( mSpillSink );
+    }
+
+    /**
+     *  Records messages lost to backpressure. Used by the dispatch path and by
+     *  sinks that discard what they were holding.
+     *
+     *  @param[in]  level     Level of the lost messages
+     *  @param[in]  count     How many were lost
+     */
+    void countDrops( const Level level, const size_t count )
+    {
+      mDropped[ std::min( static_cast<size_t>( level ), LevelCount - 1 ) ].fetch_add( count, std::memory_order_relaxed );
+    }
+
+    /**
+     *  Records a message handed to the spill sink instead of this one
+     */
+    void countSpill()
+    {
+      mSpilled.fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    /**
+     *  Number of messages at a level this sink has lost to backpressure
+     *
+     *  @param[in]  level     The level to look up
+     *  @return size_t
+     */
+    size_t getDropCount( const Level level )
+    {
+      return mDropped[ std::min( static_cast<size_t>( level ), LevelCount - 1 ) ].load( std::memory_order_relaxed );
+    }
+
+    /**
+     *  Number of messages at any level this sink has lost to backpressure
      *
+     *  @return size_t
      */
-    template<typename... Args>
-    Result flog( const Level lvl, const char *str, Args const &... args )
+    size_t getDropCount()
+    {
+      size_t total = 0;
+
+      for ( auto &count : mDropped )
+      {
+        total += count.load( std::memory_order_relaxed );
+      }
+
+      return total;
+    }
+
+    /**
+     *  Number of messages sent to the spill sink instead of this one
+     *
+     *  @return size_t
+     */
+    size_t getSpillCount()
+    {
+      return mSpilled.load( std::memory_order_relaxed );
+    }
+
+    /**
+     *  Zeroes the drop and spill counters
+     */
+    void resetDropCounts()
+    {
+      for ( auto &count : mDropped )
+      {
+        count.store( 0, std::memory_order_relaxed );
+      }
+
+      mSpilled.store( 0, std::memory_order_relaxed );
+    }
+
+    /**
+     *  Histogram of the time spent in log() for messages from the registry.
+     *  Only filled in when ULOG_ENABLE_METRICS is set.
+     *
+     *  @return LatencyHistogram &
+     */
+    LatencyHistogram &getLatency()
+    {
+      return mLatency;
+    }
+
+    /**
+     *  Formats a message and logs it with this sink only. Formatting happens in
+     *  a per-thread scratch buffer; the sink lock is only held for the write.
+     *
+     *  @param[in]  lvl       The severity level of the message to be logged
+     *  @param[in]  str       ULOG_FMT() format string, or a printf style one
+     *  @param[in]  args      Arguments referenced by the format string
+     *  @return Result
+     */
+    template<typename Fmt, typename... Args>
+    Result flog( const Level lvl, const Fmt &str, Args const &... args )
     {
       /*-------------------------------------------------
       Note to future me: If 'this' is null, you haven't
       initialized the sink yet.
       -------------------------------------------------*/
       auto result = Result::RESULT_SUCCESS;
-      this->lock();
+      ScratchBuffer scratch;
+
+      if ( !scratch.valid() )
+      {
+        return Result::RESULT_FULL;
+      }
 
       /*------------------------------------------------
       Until custom formatters are available, simply dump the thread name in there
       ------------------------------------------------*/
-      int bytesWritten = snprintf( mLogBuffer.data(), mLogBuffer.size(), "[%s] -- ", mName.data() );
-
-      if ( bytesWritten < 0 )
-      {
-        this->unlock();
-        return Result::RESULT_FAIL;
-      }
+      Format::Writer prefix( scratch.data(), scratch.size() );
+      prefix.put( "[", 1 );
+      prefix.put( mName.data(), mName.size() );
+      prefix.put( "] -- ", 5 );
 
       /*------------------------------------------------
       Attach the user's message, or what will fit anyways
       ------------------------------------------------*/
-      snprintf( mLogBuffer.data() + bytesWritten, mLogBuffer.size() - bytesWritten, str, args... );
-      result = log( lvl, mLogBuffer.data(), strlen( mLogBuffer.data() ) );
+      const size_t offset = prefix.length();
+      const size_t length = offset + Format::format( scratch.data() + offset, scratch.size() - offset, str, args... );
 
+      this->lock();
+      result = log( lvl, scratch.data(), length );
       this->unlock();
 
       return result;
@@ -166,10 +473,16 @@ namespace uLog
     friend Chimera::Thread::Lockable<SinkInterface>;
 
 
-    Level mLoggingLevel;
-    bool mSinkEnabled;
+    std::atomic<Level> mLoggingLevel;
+    std::atomic<bool> mSinkEnabled;
     std::string_view mName;
-    std::array<char, ULOG_MAX_SNPRINTF_BUFFER_LENGTH> mLogBuffer;
+    RecordFormat mRecordFormat;
+    Coalescer mCoalescer;
+    std::array<BackpressurePolicy, LevelCount> mBackpressure;
+    std::array<std::atomic<size_t>, LevelCount> mDropped; /**< Messages lost to backpressure, per level */
+    std::atomic<size_t> mSpilled;                         /**< Messages sent to mSpillSink instead */
+    SinkHandle mSpillSink;
+    LatencyHistogram mLatency;
   };
 
 }
@@ -0,0 +1,275 @@
+/********************************************************************************
+ *  File Name:
+ *    sink_mapped_ring.cpp
+ *
+ *  Description:
+ *    Implementation of the memory mapped ring file sink
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* uLog Includes */
+#include <uLog/sinks/sink_mapped_ring.hpp>
+
+#if defined( MICRO_LOGGER_HAS_MAPPED_RING_SINK ) && ( MICRO_LOGGER_HAS_MAPPED_RING_SINK == 1 )
+
+/* C++ Includes */
+#include <algorithm>
+#include <cstring>
+
+/* POSIX Includes */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace uLog
+{
+  MappedRingSink::MappedRingSink( const std::string &path, const size_t capacity ) :
+      mPath( path ), mCapacity( capacity ), mFd( -1 ), mMapSize( 0 ), mHeader( nullptr ), mData( nullptr )
+  {
+  }
+
+  MappedRingSink::~MappedRingSink()
+  {
+    close();
+  }
+
+  Result MappedRingSink::open()
+  {
+    if ( mHeader )
+    {
+      return Result::RESULT_SUCCESS;
+    }
+    else if ( ( mCapacity < ( 2 * RecordHeader + CalibrationSize ) ) || ( mCapacity > CalibrationFlag ) )
+    {
+      return Result::RESULT_FAIL;
+    }
+
+    /*------------------------------------------------
+    Size the file and map it shared so every write lands
+    directly in the page cache.
+    ------------------------------------------------*/
+    mFd = ::open( mPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644 );
+    if ( mFd < 0 )
+    {
+      return Result::RESULT_FAIL;
+    }
+
+    mMapSize  = DataOffset + mCapacity;
+    void *map = MAP_FAILED;
+
+    if ( ftruncate( mFd, static_cast<off_t>( mMapSize ) ) == 0 )
+    {
+      map = mmap( nullptr, mMapSize, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0 );
+    }
+
+    if ( map == MAP_FAILED )
+    {
+      ::close( mFd );
+      mFd = -1;
+      return Result::RESULT_FAIL;
+    }
+
+    mHeader = static_cast<RingHeader *>( map );
+    mData   = static_cast<uint8_t *>( map ) + DataOffset;
+
+    /*------------------------------------------------
+    Keep an existing ring of the same geometry so nothing
+    from before a crash is lost until it's overwritten.
+    The magic is written last so a half built header is
+    never mistaken for a valid one.
+    ------------------------------------------------*/
+    const bool valid = ( mHeader->magic == RingMagic ) && ( mHeader->version == RingVersion ) &&
+                       ( mHeader->capacity == mCapacity ) && ( mHeader->head >= mHeader->tail ) &&
+                       ( ( mHeader->head - mHeader->tail ) <= mCapacity );
+
+    if ( !valid )
+    {
+      mHeader->magic    = 0;
+      mHeader->version  = RingVersion;
+      mHeader->capacity = mCapacity;
+      mHeader->head     = 0;
+      mHeader->tail     = 0;
+      mHeader->sequence = 0;
+      __atomic_store_n( &mHeader->magic, RingMagic, __ATOMIC_RELEASE );
+    }
+
+    /*------------------------------------------------
+    Record how this process' ticks map to wall time. A
+    resumed ring with records in it keeps the header
+    calibration for those, and gets a calibration record
+    for everything after. The tick clock restarts on a
+    reboot, so the old one can't convert the new ticks.
+    ------------------------------------------------*/
+    const TickCalibration &calibration = getTickCalibration();
+
+    if ( !valid || ( mHeader->head == mHeader->tail ) )
+    {
+      mHeader->tickHz    = calibration.hz;
+      mHeader->calTick   = calibration.tick;
+      mHeader->calUnixNs = calibration.unixNs;
+    }
+    else
+    {
+      const uint64_t payload[ 3 ] = { calibration.hz, calibration.tick, calibration.unixNs };
+      append( readTick(), payload, sizeof( payload ), CalibrationFlag );
+    }
+
+    return Result::RESULT_SUCCESS;
+  }
+
+  Result MappedRingSink::close()
+  {
+    if ( !mHeader )
+    {
+      return Result::RESULT_SUCCESS;
+    }
+
+    munmap( mHeader, mMapSize );
+    ::close( mFd );
+
+    mHeader = nullptr;
+    mData   = nullptr;
+    mFd     = -1;
+
+    return Result::RESULT_SUCCESS;
+  }
+
+  Result MappedRingSink::flush()
+  {
+    /*------------------------------------------------
+    Not needed to survive a process crash, but starts
+    writeback in case the whole machine goes down.
+    ------------------------------------------------*/
+    if ( !mHeader || ( msync( mHeader, mMapSize, MS_ASYNC ) != 0 ) )
+    {
+      return Result::RESULT_FAIL;
+    }
+
+    return Result::RESULT_SUCCESS;
+  }
+
+  IOType MappedRingSink::getIOType()
+  {
+    return IOType::FILE_SINK;
+  }
+
+  Result MappedRingSink::log( const Level level, const void *const message, const size_t length )
+  {
+    /*------------------------------------------------
+    Called directly rather than through the registry,
+    so nothing is holding the sink lock yet
+    ------------------------------------------------*/
+    this->lock();
+    const Result result = log( level, readTick(), message, length );
+    this->unlock();
+
+    return result;
+  }
+
+  Result MappedRingSink::log( const Level level, const Tick tick, const void *const message, const size_t length )
+  {
+    /*------------------------------------------------
+    Check to see if we should even write
+    ------------------------------------------------*/
+    if ( !isEnabled() || ( level < getLogLevel() ) || !message || !length || !mHeader )
+    {
+      return Result::RESULT_FAIL;
+    }
+
+    /*------------------------------------------------
+    The registry holds the sink lock across this call
+    ------------------------------------------------*/
+    append( tick, message, length );
+    return Result::RESULT_SUCCESS;
+  }
+
+  bool MappedRingSink::panicLog( const Level level, const Tick tick, const void *const message, const size_t length )
+  {
+    /*------------------------------------------------
+    Only memory is touched, and the mapping outlives the
+    process, so no flush is needed either.
+    ------------------------------------------------*/
+    if ( !isEnabled() || ( level < getLogLevel() ) || !message || !length || !mHeader )
+    {
+      return false;
+    }
+
+    append( tick, message, length );
+    return true;
+  }
+
+  void MappedRingSink::append( const Tick tick, const void *const message, const size_t length, const uint32_t flags )
+  {
+    const size_t payload = std::min( length, mCapacity - RecordHeader );
+    const uint64_t total = RecordHeader + payload;
+    const uint64_t head  = mHeader->head;
+    uint64_t tail        = mHeader->tail;
+
+    /*------------------------------------------------
+    Retire the oldest records until the new one fits. The
+    tail must be published before their bytes are reused.
+    A retired calibration record moves into the header,
+    which covers the records up to the first one left.
+    ------------------------------------------------*/
+    while ( ( head + total - tail ) > mCapacity )
+    {
+      uint32_t oldLength = 0;
+      ringRead( tail, &oldLength, sizeof( oldLength ) );
+
+      if ( oldLength & CalibrationFlag )
+      {
+        uint64_t calibration[ 3 ] = {};
+        ringRead( tail + RecordHeader, calibration, sizeof( calibration ) );
+
+        mHeader->tickHz    = calibration[ 0 ];
+        mHeader->calTick   = calibration[ 1 ];
+        mHeader->calUnixNs = calibration[ 2 ];
+      }
+
+      tail += RecordHeader + ( oldLength & ~CalibrationFlag );
+    }
+
+    __atomic_store_n( &mHeader->tail, tail, __ATOMIC_RELEASE );
+
+    /*------------------------------------------------
+    Write the record, then publish it by moving the head
+    ------------------------------------------------*/
+    const uint32_t recordHeader[ 2 ] = { static_cast<uint32_t>( payload ) | flags, static_cast<uint32_t>( mHeader->sequence ) };
+
+    ringWrite( head, recordHeader, sizeof( recordHeader ) );
+    ringWrite( head + sizeof( recordHeader ), &tick, sizeof( tick ) );
+    ringWrite( head + RecordHeader, message, payload );
+
+    /*------------------------------------------------
+    Calibration records aren't log records, so they
+    leave the sequence numbers alone
+    ------------------------------------------------*/
+    if ( !flags )
+    {
+      mHeader->sequence++;
+    }
+
+    __atomic_store_n( &mHeader->head, head + total, __ATOMIC_RELEASE );
+  }
+
+  void MappedRingSink::ringWrite( uint64_t offset, const void *const src, const size_t length )
+  {
+    const size_t start = static_cast<size_t>( offset % mCapacity );
+    const size_t first = std::min( length, mCapacity - start );
+
+    memcpy( mData + start, src, first );
+    memcpy( mData, static_cast<const uint8_t *>( src ) + first, length - first );
+  }
+
+  void MappedRingSink::ringRead( uint64_t offset, void *const dst, const size_t length ) const
+  {
+    const size_t start = static_cast<size_t>( offset % mCapacity );
+    const size_t first = std::min( length, mCapacity - start );
+
+    memcpy( dst, mData + start, first );
+    memcpy( static_cast<uint8_t *>( dst ) + first, mData, length - first );
+  }
+}    // namespace uLog
+
+#endif /* MICRO_LOGGER_HAS_MAPPED_RING_SINK */
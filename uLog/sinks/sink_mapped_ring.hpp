@@ -0,0 +1,102 @@
+/********************************************************************************
+ *  File Name:
+ *    sink_mapped_ring.hpp
+ *
+ *  Description:
+ *    Crash persistent sink that writes records into a fixed size, memory mapped
+ *    circular file. Logging is a bounded memcpy with no system call; the pages
+ *    belong to the kernel so they survive the process dying. Recover the ring
+ *    with tools/ulog_ring_reader.py.
+ *
+ *    File layout (native endian):
+ *      RingHeader, padded to DataOffset bytes
+ *      capacity bytes of record data, each record being
+ *        u32   Payload length, with CalibrationFlag set on a calibration record
+ *        u32   Low 32 bits of the record sequence number
+ *        u64   Raw tick captured by uLog::log(), see RingHeader for conversion
+ *        ...   Payload, wrapping around the end of the data area
+ *
+ *    A process resuming a ring that still holds records appends a calibration
+ *    record, whose payload is the u64 tick rate, tick and wall clock ns of that
+ *    process. The records after it convert with those instead of the header's.
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_SINK_MAPPED_RING_HPP
+#define MICRO_LOGGER_SINK_MAPPED_RING_HPP
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#define MICRO_LOGGER_HAS_MAPPED_RING_SINK ( 1 )
+
+/* C++ Includes */
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+/* uLog Includes */
+#include <uLog/config.hpp>
+#include <uLog/sinks/sink_intf.hpp>
+#include <uLog/types.hpp>
+
+namespace uLog
+{
+  class MappedRingSink : public SinkInterface
+  {
+  public:
+    /**
+     *  Lives at the start of the mapped file. Offsets are byte counts written
+     *  since the ring was created, taken modulo capacity to find the position.
+     */
+    struct RingHeader
+    {
+      uint32_t magic;     /**< RingMagic once initialized */
+      uint32_t version;   /**< RingVersion */
+      uint64_t capacity;  /**< Size of the record area in bytes */
+      uint64_t head;      /**< End of the newest complete record */
+      uint64_t tail;      /**< Start of the oldest intact record */
+      uint64_t sequence;  /**< Sequence number of the next record */
+      uint64_t tickHz;    /**< Rate of the record ticks, up to the first calibration record */
+      uint64_t calTick;   /**< Tick at which calUnixNs was sampled */
+      uint64_t calUnixNs; /**< Wall clock ns since the Unix epoch at calTick, or zero */
+    };
+
+    static constexpr uint32_t RingMagic       = 0x47524C55; /* "ULRG" */
+    static constexpr uint32_t RingVersion     = 3;
+    static constexpr uint32_t CalibrationFlag = 0x80000000u; /* Set in a calibration record's length */
+    static constexpr size_t DataOffset        = 64;
+    static constexpr size_t RecordHeader      = 2 * sizeof( uint32_t ) + sizeof( Tick );
+    static constexpr size_t CalibrationSize   = 3 * sizeof( uint64_t );
+
+    static_assert( sizeof( RingHeader ) <= DataOffset );
+
+    MappedRingSink( const std::string &path, const size_t capacity = ULOG_MAPPED_RING_DEFAULT_CAPACITY );
+    ~MappedRingSink();
+
+    Result open() final override;
+    Result close() final override;
+    Result flush() final override;
+    IOType getIOType() final override;
+    Result log( const Level level, const void *const message, const size_t length ) final override;
+    Result log( const Level level, const Tick tick, const void *const message, const size_t length ) final override;
+    bool panicLog( const Level level, const Tick tick, const void *const message, const size_t length ) final override;
+
+  private:
+    const std::string mPath;
+    const size_t mCapacity;
+
+    int mFd;
+    size_t mMapSize;
+    RingHeader *mHeader;
+    uint8_t *mData;
+
+    void append( const Tick tick, const void *const message, const size_t length, const uint32_t flags = 0 );
+    void ringWrite( uint64_t offset, const void *const src, const size_t length );
+    void ringRead( uint64_t offset, void *const dst, const size_t length ) const;
+  };
+}    // namespace uLog
+
+#endif /* __unix__ || __APPLE__ */
+
+#endif /* !MICRO_LOGGER_SINK_MAPPED_RING_HPP */
@@ -0,0 +1,170 @@
+/********************************************************************************
+ *  File Name:
+ *    sink_storage.hpp
+ *
+ *  Description:
+ *    Allocation free homes for sinks. SinkStorage placement constructs sinks
+ *    inside a fixed block of static memory, and uLog::makeSink() picks between
+ *    that and std::make_shared depending on ULOG_STATIC_SINK_STORAGE, so
+ *    application code reads the same in either mode:
+ *
+ *      uLog::SinkHandle console = uLog::makeSink<uLog::ConsoleSink>();
+ *      uLog::registerSink( console );
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_SINK_STORAGE_HPP
+#define MICRO_LOGGER_SINK_STORAGE_HPP
+
+/* C++ Includes */
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/* uLog Includes */
+#include <uLog/config.hpp>
+#include <uLog/types.hpp>
+#include <uLog/sinks/sink_intf.hpp>
+
+namespace uLog
+{
+  /**
+   *  Fixed capacity storage for sinks of one type. Slots are claimed without
+   *  locks, so sinks may be created from any thread. Nothing is destroyed
+   *  automatically; a sink lives until destroy() is called on it.
+   */
+  template<typename T, size_t COUNT>
+  class SinkStorage
+  {
+    static_assert( std::is_base_of_v<SinkInterface, T>, "SinkStorage only holds sinks" );
+
+  public:
+    constexpr SinkStorage() : mSlots{}, mUsed{}
+    {
+    }
+
+    SinkStorage( const SinkStorage & ) = delete;
+    SinkStorage &operator=( const SinkStorage & ) = delete;
+
+    /**
+     *  Constructs a sink in the first free slot
+     *
+     *  @param[in]  args      Forwarded to the sink's constructor
+     *  @return T *           The new sink, or nullptr if every slot is taken
+     */
+    template<typename... Args>
+    T *create( Args &&... args )
+    {
+      for ( size_t i = 0; i < COUNT; i++ )
+      {
+        if ( !mUsed[ i ].exchange( true, std::memory_order_acquire ) )
+        {
+          return new ( mSlots[ i ].data ) T( std::forward<Args>( args )... );
+        }
+      }
+
+      return nullptr;
+    }
+
+    /**
+     *  Destroys a sink made by create() and frees its slot. The sink must
+     *  already be removed from the registry.
+     *
+     *  @param[in]  sink      The sink to destroy
+     *  @return bool          False if the sink doesn't live here
+     */
+    bool destroy( SinkInterface *const sink )
+    {
+      for ( size_t i = 0; i < COUNT; i++ )
+      {
+        T *const slot = std::launder( reinterpret_cast<T *>( mSlots[ i ].data ) );
+
+        if ( mUsed[ i ].load( std::memory_order_relaxed ) && ( static_cast<SinkInterface *>( slot ) == sink ) )
+        {
+          slot->~T();
+          mUsed[ i ].store( false, std::memory_order_release );
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    /**
+     *  Number of sinks the storage can hold
+     *
+     *  @return size_t
+     */
+    static constexpr size_t capacity()
+    {
+      return COUNT;
+    }
+
+  private:
+    struct Slot
+    {
+      alignas( T ) uint8_t data[ sizeof( T ) ];
+    };
+
+    std::array<Slot, COUNT> mSlots;
+    std::array<std::atomic<bool>, COUNT> mUsed;
+  };
+
+#if ( ULOG_STATIC_SINK_STORAGE == 1 )
+  /**
+   *  Storage backing makeSink() for one sink type
+   *
+   *  @return SinkStorage &
+   */
+  template<typename T>
+  SinkStorage<T, ULOG_STATIC_SINKS_PER_TYPE> &sinkStorage()
+  {
+    static SinkStorage<T, ULOG_STATIC_SINKS_PER_TYPE> storage;
+    return storage;
+  }
+#endif /* ULOG_STATIC_SINK_STORAGE */
+
+  /**
+   *  Creates a sink. With ULOG_STATIC_SINK_STORAGE set, it is placement
+   *  constructed in static storage sized by ULOG_STATIC_SINKS_PER_TYPE and the
+   *  handle is a plain pointer; otherwise it comes from std::make_shared.
+   *
+   *  @param[in]  args      Forwarded to the sink's constructor
+   *  @return SinkHandle    nullptr if the static storage is used up
+   */
+  template<typename T, typename... Args>
+  SinkHandle makeSink( Args &&... args )
+  {
+#if ( ULOG_STATIC_SINK_STORAGE == 1 )
+    return sinkStorage<T>().create( std::forward<Args>( args )... );
+#else
+    return std::make_shared<T>( std::forward<Args>( args )... );
+#endif /* ULOG_STATIC_SINK_STORAGE */
+  }
+
+  /**
+   *  Releases a sink made by makeSink() and clears the handle. In static mode
+   *  the sink is destroyed and its slot reused, so it must already be removed
+   *  from the registry. Otherwise this just drops the caller's reference.
+   *
+   *  @param[in]  sink      Handle from makeSink<T>()
+   *  @return void
+   */
+  template<typename T>
+  void releaseSink( SinkHandle &sink )
+  {
+#if ( ULOG_STATIC_SINK_STORAGE == 1 )
+    sinkStorage<T>().destroy( sink );
+#endif /* ULOG_STATIC_SINK_STORAGE */
+    sink = nullptr;
+  }
+}    // namespace uLog
+
+#endif /* !MICRO_LOGGER_SINK_STORAGE_HPP */
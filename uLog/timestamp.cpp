@@ -0,0 +1,43 @@
+/********************************************************************************
+ *  File Name:
+ *    timestamp.cpp
+ *
+ *  Description:
+ *    Tick calibration and conversion
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+/* uLog Includes */
+#include <uLog/timestamp.hpp>
+
+namespace uLog
+{
+  static TickCalibration tickCalibration = { 0, 0, ULOG_TICK_HZ };
+
+  void calibrateTicks( const uint64_t unixNs )
+  {
+    tickCalibration.tick   = readTick();
+    tickCalibration.unixNs = unixNs;
+  }
+
+  const TickCalibration &getTickCalibration()
+  {
+    return tickCalibration;
+  }
+
+  uint64_t tickToUnixNanoseconds( const Tick tick )
+  {
+    /*------------------------------------------------
+    Ticks read before calibration land behind it, but
+    never before the epoch
+    ------------------------------------------------*/
+    if ( tick >= tickCalibration.tick )
+    {
+      return tickCalibration.unixNs + ticksToNanoseconds( tick - tickCalibration.tick );
+    }
+
+    const uint64_t behind = ticksToNanoseconds( tickCalibration.tick - tick );
+    return ( behind < tickCalibration.unixNs ) ? ( tickCalibration.unixNs - behind ) : 0;
+  }
+}    // namespace uLog
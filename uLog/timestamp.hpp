@@ -0,0 +1,102 @@
+/********************************************************************************
+ *  File Name:
+ *    timestamp.hpp
+ *
+ *  Description:
+ *    Raw monotonic ticks captured with every record. Reading a tick is a single
+ *    counter or clock read; turning it into a time is left to whoever needs it,
+ *    using the calibration pair recorded once at start up.
+ *
+ *  2026 | Brandon Braun | brandonbraun653@gmail.com
+ ********************************************************************************/
+
+#pragma once
+#ifndef MICRO_LOGGER_TIMESTAMP_HPP
+#define MICRO_LOGGER_TIMESTAMP_HPP
+
+/* C++ Includes */
+#include <cstdint>
+
+/* uLog Includes */
+#include <uLog/config.hpp>
+
+#if !defined( ULOG_TICK_READ )
+#if defined( __linux__ )
+#include <time.h>
+#else
+#include <Chimera/common>
+#endif
+#endif
+
+namespace uLog
+{
+  /**
+   *  Free running counter value at ULOG_TICK_HZ
+   */
+  using Tick = uint64_t;
+
+  /**
+   *  Ties the tick counter to wall clock time
+   */
+  struct TickCalibration
+  {
+    Tick tick;       /**< Counter value at the moment of calibration */
+    uint64_t unixNs; /**< Wall clock at that moment, ns since the Unix epoch. Zero if unknown. */
+    uint64_t hz;     /**< Counter rate */
+  };
+
+  /**
+   *  Reads the tick counter
+   *  @return Tick
+   */
+  inline Tick readTick()
+  {
+#if defined( ULOG_TICK_READ )
+    return static_cast<Tick>( ULOG_TICK_READ );
+#elif defined( __linux__ )
+    timespec now;
+    clock_gettime( CLOCK_MONOTONIC_RAW, &now );
+    return static_cast<Tick>( now.tv_sec ) * 1000000000ull + static_cast<Tick>( now.tv_nsec );
+#else
+    return static_cast<Tick>( Chimera::micros() );
+#endif
+  }
+
+  /**
+   *  Records the wall clock time that corresponds to the current tick. Called by
+   *  uLog::initialize() on hosts with a real time clock; embedded targets call it
+   *  once their RTC is known. Not safe to call while other threads convert ticks.
+   *
+   *  @param[in]  unixNs    Current wall clock time in ns since the Unix epoch
+   *  @return void
+   */
+  void calibrateTicks( const uint64_t unixNs );
+
+  /**
+   *  Gets the calibration recorded by calibrateTicks()
+   *  @return const TickCalibration &
+   */
+  const TickCalibration &getTickCalibration();
+
+  /**
+   *  Converts a tick count into nanoseconds without overflowing for large counts
+   *
+   *  @param[in]  ticks     Number of ticks
+   *  @return uint64_t
+   */
+  constexpr uint64_t ticksToNanoseconds( const Tick ticks )
+  {
+    return ( ticks / ULOG_TICK_HZ ) * 1000000000ull + ( ( ticks % ULOG_TICK_HZ ) * 1000000000ull ) / ULOG_TICK_HZ;
+  }
+
+  /**
+   *  Converts a tick captured after calibration into wall clock time
+   *
+   *  @param[in]  tick      Tick read from the counter
+   *  @return uint64_t      Nanoseconds since the Unix epoch, zero for a tick
+   *                        that would land before it
+   */
+  uint64_t tickToUnixNanoseconds( const Tick tick );
+}    // namespace uLog
+
+#endif /* !MICRO_LOGGER_TIMESTAMP_HPP */
@@ -16,6 +16,9 @@
 #include <cstdint>
 #include <memory>
 
+/* uLog Includes */
+#include <uLog/config.hpp>
+
 namespace uLog
 {
   enum class Result : size_t 
@@ -46,11 +49,63 @@ namespace uLog
     LVL_MAX = LVL_FATAL
   };
 
+  static constexpr size_t LevelCount = static_cast<size_t>( Level::LVL_MAX ) + 1;
+
+  static_assert( static_cast<size_t>( Level::LVL_TRACE ) == ULOG_LEVEL_TRACE );
+  static_assert( static_cast<size_t>( Level::LVL_DEBUG ) == ULOG_LEVEL_DEBUG );
+  static_assert( static_cast<size_t>( Level::LVL_INFO ) == ULOG_LEVEL_INFO );
+  static_assert( static_cast<size_t>( Level::LVL_WARN ) == ULOG_LEVEL_WARN );
+  static_assert( static_cast<size_t>( Level::LVL_ERROR ) == ULOG_LEVEL_ERROR );
+  static_assert( static_cast<size_t>( Level::LVL_FATAL ) == ULOG_LEVEL_FATAL );
+
+  /**
+   *  Checks if call sites at the given level survive ULOG_COMPILE_TIME_MIN_LEVEL
+   *
+   *  @param[in]  level     The level to check
+   *  @return bool
+   */
+  constexpr bool isCompiledIn( const Level level )
+  {
+    return static_cast<size_t>( level ) >= ULOG_COMPILE_TIME_MIN_LEVEL;
+  }
+
+  /**
+   *  Identifies the subsystem a message came from. Each module can be given its
+   *  own minimum level with uLog::setModuleLevel(). IDs at or above
+   *  ULOG_MAX_MODULES are treated as DefaultModule.
+   */
+  using ModuleId = uint16_t;
+
+  static constexpr ModuleId DefaultModule = 0;
+
+  /**
+   *  What a sink does with a message it can't take right away, either because
+   *  another thread holds the sink or because its buffers are full. Every
+   *  policy first waits up to BackpressurePolicy::waitMs for the sink.
+   */
+  enum class Backpressure : uint8_t
+  {
+    BLOCK,       /**< Keep waiting, then drop the message once the wait runs out */
+    DROP_NEWEST, /**< Drop the message being logged */
+    DROP_OLDEST, /**< Discard the oldest messages the sink is still holding to make room */
+    SPILL        /**< Hand the message to the sink's spill sink instead */
+  };
+
+  static constexpr size_t WaitForever = static_cast<size_t>( -1 );
+
+  struct BackpressurePolicy
+  {
+    Backpressure action; /**< What to do once the wait runs out */
+    size_t waitMs;       /**< How long to wait for the sink, or WaitForever */
+  };
+
   enum Config : size_t
   {
     CFG_NONE = 0,
     CFG_INITIALIZE_ALWAYS               = ( 1u << 0 ), /**< Like the name says, always initialize */
-    CFG_INITIALIZE_IFF_SINK_UNIQUE_TYPE = ( 1u << 1 )  /**< Only initialize the sink if it's the only one of its kind */
+    CFG_INITIALIZE_IFF_SINK_UNIQUE_TYPE = ( 1u << 1 ), /**< Only initialize the sink if it's the only one of its kind */
+    CFG_DELIVERY_QUEUED                 = ( 1u << 2 ), /**< Deliver from the sink's own queue, serviced by the worker pool */
+    CFG_DELIVERY_DEDICATED              = ( 1u << 3 )  /**< Deliver from the sink's own queue, serviced by its own worker */
   };
 
   enum class IOType : size_t
@@ -63,7 +118,26 @@ namespace uLog
 
   class SinkInterface;
 
+#if ( ULOG_STATIC_SINK_STORAGE == 1 )
+  using SinkHandle = SinkInterface *;
+#else
   using SinkHandle = std::shared_ptr<SinkInterface>;
+#endif /* ULOG_STATIC_SINK_STORAGE */
+
+  /**
+   *  Gets the sink behind a handle without touching a reference count
+   *
+   *  @param[in]  handle    The handle to look through
+   *  @return SinkInterface *
+   */
+  inline SinkInterface *sinkPointer( const SinkHandle &handle )
+  {
+#if ( ULOG_STATIC_SINK_STORAGE == 1 )
+    return handle;
+#else
+    return handle.get();
+#endif /* ULOG_STATIC_SINK_STORAGE */
+  }
 }
 
 #endif  /* MICRO_LOGGER_TYPES_HPP */
\ No newline at end of file
@@ -9,229 +9,2727 @@
  ********************************************************************************/
 
 /* C++ Includes */
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <cstdio>
 #include <limits>
 #include <mutex>
 #include <string>
+#include <utility>
+
+/* POSIX Includes */
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <time.h>
+#endif
 
 /* Chimera Includes */
+#include <Chimera/common>
 #include <Chimera/thread>
 
-/* uLog Includes */
-#include <uLog/config.hpp>
-#include <uLog/sinks/sink_intf.hpp>
-#include <uLog/types.hpp>
-#include <uLog/ulog.hpp>
+/* uLog Includes */
+#include <uLog/config.hpp>
+#include <uLog/metrics.hpp>
+#include <uLog/queue/mpmc_ring.hpp>
+#include <uLog/queue/spsc_ring.hpp>
+#include <uLog/record.hpp>
+#include <uLog/sinks/sink_intf.hpp>
+#include <uLog/timestamp.hpp>
+#include <uLog/types.hpp>
+#include <uLog/ulog.hpp>
+
+
+namespace uLog
+{
+  static bool uLogInitialized      = false;
+  static std::atomic<Level> globalLogLevel( Level::LVL_MIN );
+#if ( ULOG_STATIC_SINK_STORAGE == 1 )
+  static std::atomic<SinkHandle> globalRootSink( nullptr );
+#else
+  static SinkHandle globalRootSink = nullptr; /**< Only accessed through std::atomic_load/atomic_store */
+#endif
+  static std::array<SinkHandle, ULOG_MAX_REGISTERABLE_SINKS> sinkRegistry;
+
+  static size_t defaultLockTimeout = 100;
+  static Chimera::Thread::RecursiveTimedMutex threadLock;
+
+  /**
+   *  Looks up the registry index associated with a particular sink handle
+   *
+   *  @param[in]  sinkHandle  The handle to search for
+   *  @return size_t
+   */
+  static size_t getSinkOffsetIndex( const SinkHandle &sinkHandle );
+
+  struct DeliveryQueue;
+
+  /**
+   *  Immutable, compacted view of the registry read by the dispatch path. Two
+   *  buffers alternate: one is published while the other is rebuilt on the next
+   *  registry change. Readers announce themselves through snapshotReaders so a
+   *  writer knows when a retired buffer (and the sinks it names) is unused.
+   */
+  struct SinkSnapshot
+  {
+    size_t count;                                                   /**< Valid entries in sinks */
+    std::array<SinkInterface *, ULOG_MAX_REGISTERABLE_SINKS> sinks; /**< Registered sinks, no gaps */
+#if ( ULOG_ENABLE_DELIVERY_WORKERS == 1 )
+    std::array<DeliveryQueue *, ULOG_MAX_REGISTERABLE_SINKS> queues; /**< Each sink's delivery queue, nullptr if fed inline */
+#endif
+  };
+
+  static std::array<SinkSnapshot, 2> snapshotBuffers;
+  static std::array<std::atomic<size_t>, 2> snapshotReaders;
+  static std::atomic<size_t> activeSnapshot( 0 );
+
+  /*-------------------------------------------------
+  Per module filtering. Each mask has bit N set when a
+  message at level N passes the module's threshold and
+  at least one enabled sink wants it, so a log call is filtered
+  with one indexed load. Overrides hold the level plus
+  one, so the zero initialized table means "use the
+  global level".
+  -------------------------------------------------*/
+  static constexpr uint8_t NoOverride = 0;
+  static constexpr uint8_t AllLevels  = ( 1u << ( static_cast<size_t>( Level::LVL_MAX ) + 1 ) ) - 1;
+
+  static std::array<std::atomic<uint8_t>, ULOG_MAX_MODULES> moduleOverrides;
+  /**
+   *  Builds the initial mask table, which lets every level through until
+   *  the first refresh knows better
+   */
+  template<size_t... Modules>
+  static constexpr std::array<std::atomic<uint8_t>, sizeof...( Modules )> allLevelMasks( std::index_sequence<Modules...> )
+  {
+    return { { ( static_cast<void>( Modules ), AllLevels )... } };
+  }
+
+  static std::array<std::atomic<uint8_t>, ULOG_MAX_MODULES> moduleMasks = allLevelMasks( std::make_index_sequence<ULOG_MAX_MODULES>{} );
+  static std::atomic<size_t> levelGeneration( 0 ); /**< Bumped after any input to the masks changes */
+
+  /**
+   *  Maps a module ID onto its slot in the filter tables
+   */
+  static inline size_t moduleSlot( const ModuleId module )
+  {
+    return ( module < ULOG_MAX_MODULES ) ? module : DefaultModule;
+  }
+
+  /**
+   *  Checks a level against a module's filter mask
+   */
+  static inline bool moduleAccepts( const ModuleId module, const Level level )
+  {
+    return moduleMasks[ moduleSlot( module ) ].load( std::memory_order_relaxed ) & ( 1u << static_cast<size_t>( level ) );
+  }
+
+  /**
+   *  Recomputes every module's mask from its override, the global level and
+   *  the levels of the sinks in the published snapshot. Takes no lock, so a
+   *  sink may change its level from inside log(). A refresh that raced with
+   *  a change to any of its inputs is redone.
+   *
+   *  @return void
+   */
+  static void refreshModuleMasks();
+
+  /**
+   *  Records that an input to the module masks changed, then refreshes them
+   *
+   *  @return void
+   */
+  static void levelsChanged();
+
+#if ( ULOG_HAS_THREAD_LOCAL == 1 )
+  static thread_local size_t registryPins = 0;     /**< Snapshots and reserved sinks this thread holds */
+  static thread_local bool deliveryThread = false; /**< The thread is the async drain or a delivery worker */
+  static thread_local size_t queueClaims  = 0;     /**< Queue cells this thread holds for a Reservation */
+#endif
+
+  /**
+   *  Notes that the calling thread holds something a registry change has to
+   *  wait for: a snapshot, or a sink reserved for a Reservation
+   */
+  static inline void pinRegistry()
+  {
+#if ( ULOG_HAS_THREAD_LOCAL == 1 )
+    registryPins++;
+#endif
+  }
+
+  /**
+   *  Undoes pinRegistry()
+   */
+  static inline void unpinRegistry()
+  {
+#if ( ULOG_HAS_THREAD_LOCAL == 1 )
+    registryPins--;
+#endif
+  }
+
+  /**
+   *  Checks if a registry change made by the calling thread would wait on the
+   *  thread itself. Always false without thread_local support.
+   */
+  static inline bool registryPinned()
+  {
+#if ( ULOG_HAS_THREAD_LOCAL == 1 )
+    return registryPins != 0;
+#else
+    return false;
+#endif
+  }
+
+  /**
+   *  Notes that the calling thread holds a claimed but unpublished queue cell,
+   *  which the drain can't get past until the thread publishes it
+   *
+   *  @param[in]  held      True when claiming, false when publishing
+   */
+  static inline void holdQueueClaim( const bool held )
+  {
+#if ( ULOG_HAS_THREAD_LOCAL == 1 )
+    held ? queueClaims++ : queueClaims--;
+#else
+    ( void )held;
+#endif
+  }
+
+  /**
+   *  Checks if flush() may run on the calling thread. It waits for the async
+   *  drain and the delivery workers and takes every sink lock, so it can't be
+   *  called by one of those threads, by a thread inside a sink, or by one
+   *  holding a queue cell the drain is stuck behind. Always true without
+   *  thread_local support.
+   */
+  static inline bool flushAllowed()
+  {
+#if ( ULOG_HAS_THREAD_LOCAL == 1 )
+    return !deliveryThread && !registryPins && !queueClaims;
+#else
+    return true;
+#endif
+  }
+
+  /**
+   *  Marks the calling thread as one flush() waits on
+   */
+  static inline void markDeliveryThread()
+  {
+#if ( ULOG_HAS_THREAD_LOCAL == 1 )
+    deliveryThread = true;
+#endif
+  }
+
+  /**
+   *  RAII read access to the currently published registry snapshot
+   */
+  class SnapshotReader
+  {
+  public:
+    SnapshotReader() : mIndex( enter() )
+    {
+    }
+
+    ~SnapshotReader()
+    {
+      leave( mIndex );
+    }
+
+    const SinkSnapshot *operator->() const
+    {
+      return &snapshotBuffers[ mIndex ];
+    }
+
+    /**
+     *  Announces a reader of the current snapshot, for holders that outlive a
+     *  scope. Must be paired with leave().
+     *
+     *  @return size_t    Index of the snapshot being read
+     */
+    static size_t enter()
+    {
+      while ( true )
+      {
+        const size_t index = activeSnapshot.load( std::memory_order_seq_cst );
+        snapshotReaders[ index ].fetch_add( 1, std::memory_order_seq_cst );
+
+        /*------------------------------------------------
+        Make sure a writer didn't retire this buffer between
+        the load and announcing ourselves as a reader. Both
+        sides are seq_cst: the writer stores the index then
+        reads the count, the reader the reverse, and weaker
+        orderings let each miss the other's store.
+        ------------------------------------------------*/
+        if ( activeSnapshot.load( std::memory_order_seq_cst ) == index )
+        {
+          pinRegistry();
+          return index;
+        }
+
+        snapshotReaders[ index ].fetch_sub( 1, std::memory_order_release );
+      }
+    }
+
+    /**
+     *  Undoes enter()
+     *
+     *  @param[in]  index   Value returned by enter()
+     */
+    static void leave( const size_t index )
+    {
+      unpinRegistry();
+      snapshotReaders[ index ].fetch_sub( 1, std::memory_order_release );
+    }
+
+  private:
+    const size_t mIndex;
+  };
+
+  /**
+   *  Rebuilds the dispatch snapshot from sinkRegistry and publishes it. Returns
+   *  only once no reader can still see the previous snapshot, so sinks dropped
+   *  from the registry are safe to close afterwards. The caller must hold the
+   *  registry lock.
+   *
+   *  @return void
+   */
+  static void publishSnapshot();
+
+  /**
+   *  Hands a message to every registered sink that will accept it. Only needs
+   *  each sink's own lock, not the registry lock.
+   *
+   *  @param[in]  info      Level, timestamp and origin of the message
+   *  @param[in]  message   Raw byte message to be logged
+   *  @param[in]  length    Length of the message
+   *  @return Result        RESULT_FULL, or RESULT_FAIL_MSG_TOO_LONG for a record
+   *                        too long for a binary sink, if any sink dropped it
+   */
+  static Result dispatch( const RecordInfo &info, const void *const message, const size_t length );
+
+  /**
+   *  Hands a message to one sink right away, applying the sink's backpressure
+   *  policy and coalescing. A loss is counted against the sink.
+   *
+   *  @param[in]  sink      The sink to write to
+   *  @param[in]  info      Level, timestamp and origin of the message
+   *  @param[in]  message   Raw byte message to be logged
+   *  @param[in]  length    Length of the message
+   *  @param[in]  hash      Coalescer::hash() of the message, if coalescing
+   *  @param[in]  now       Chimera::millis() at dispatch, if coalescing
+   *  @return Result        RESULT_FULL if the sink dropped the message
+   */
+  static Result deliverToSink( SinkInterface *const sink, const RecordInfo &info, const void *const message,
+                               const size_t length, const uint64_t hash, const size_t now );
+
+  /**
+   *  Takes a sink's lock and waits for room in it, both bounded by the policy's
+   *  wait. Makes room with discardOldest() for Backpressure::DROP_OLDEST. On
+   *  failure the sink is left unlocked.
+   *
+   *  @param[in]  sink      The sink to acquire
+   *  @param[in]  policy    Backpressure policy for the message's level
+   *  @param[in]  length    Length of the message payload
+   *  @return bool          True if the sink is locked and ready for the message
+   */
+  static bool acquireSink( SinkInterface *const sink, const BackpressurePolicy &policy, const size_t length );
+
+  /**
+   *  Hands a message a sink couldn't take to that sink's spill sink, waiting
+   *  on it no longer than the policy allows
+   *
+   *  @param[in]  sink      The overloaded sink
+   *  @param[in]  policy    Backpressure policy for the message's level
+   *  @param[in]  info      Level, timestamp and origin of the message
+   *  @param[in]  message   Raw byte message to be logged
+   *  @param[in]  length    Length of the message
+   *  @return bool          True if the spill sink took the message
+   */
+  static bool spillRecord( SinkInterface *const sink, const BackpressurePolicy &policy, const RecordInfo &info,
+                           const void *const message, const size_t length );
+
+  /**
+   *  Checks if a sink's record format can carry a message. Deferred records are
+   *  only meaningful framed in a binary stream; a text sink would print their
+   *  encoded arguments.
+   *
+   *  @param[in]  sink      The sink to check
+   *  @param[in]  info      Type of the message
+   *  @return bool
+   */
+  static inline bool formatAccepts( SinkInterface *const sink, const RecordInfo &info )
+  {
+    return ( info.type != RecordType::DEFERRED ) || ( sink->getRecordFormat() == RecordFormat::BINARY );
+  }
+
+  /**
+   *  Hands one message to one sink in the format the sink asked for. The caller
+   *  must hold the sink lock.
+   *
+   *  @param[in]  sink      The sink to write to
+   *  @param[in]  info      Level, timestamp and origin of the message
+   *  @param[in]  message   Raw byte message to be logged
+   *  @param[in]  length    Length of the message
+   *  @return Result        RESULT_FAIL_MSG_TOO_LONG, counted as a drop, if a
+   *                        binary record can't hold the message, or
+   *                        RESULT_FAIL for a deferred record to a text sink
+   */
+  static Result deliver( SinkInterface *const sink, const RecordInfo &info, const void *const message, const size_t length );
+
+  /**
+   *  Hands one message to one sink from panicFlush(). Takes no locks and
+   *  skips coalescing and backpressure.
+   *
+   *  @param[in]  sink      The sink to write to
+   *  @param[in]  info      Level, timestamp and origin of the message
+   *  @param[in]  message   Raw byte message to be logged
+   *  @param[in]  length    Length of the message
+   *  @return void
+   */
+  static void panicDeliver( SinkInterface *const sink, const RecordInfo &info, const void *const message, const size_t length );
+
+  static std::atomic_flag panicActive = ATOMIC_FLAG_INIT; /**< Set once panicFlush() has started */
+  static std::atomic<uint32_t> recordSequence( 0 ); /**< Sequence number of the next record */
+  static constexpr size_t RepeatSummaryLength = 48; /**< Room for the coalescing summary line */
+
+  /*-------------------------------------------------
+  Self-metrics, see uLog/metrics.hpp. Only touched
+  through countMetric() so they compile out entirely
+  when ULOG_ENABLE_METRICS is off.
+  -------------------------------------------------*/
+  static std::array<std::atomic<size_t>, LevelCount> metricLogged;
+  static std::array<std::atomic<size_t>, LevelCount> metricFiltered;
+  static std::atomic<size_t> metricLockTimeouts( 0 );
+  static std::atomic<size_t> metricLockWaits( 0 );
+  static std::atomic<uint64_t> metricLockWaitNs( 0 );
+
+  static std::atomic<size_t> metricsDumpDue( 0 );      /**< Time of the next periodic dump in ms, zero when off */
+  static std::atomic<size_t> metricsDumpInterval( 0 ); /**< Time between periodic dumps in ms */
+  static SinkHandle metricsDumpSink = nullptr;         /**< Guarded by threadLock */
+
+  template<typename T>
+  static inline void countMetric( std::atomic<T> &counter, const T amount = 1 )
+  {
+#if ( ULOG_ENABLE_METRICS == 1 )
+    counter.fetch_add( amount, std::memory_order_relaxed );
+#else
+    ( void )counter;
+    ( void )amount;
+#endif
+  }
+
+  /**
+   *  Takes a lock, giving up after 'timeout' milliseconds. The clock is only
+   *  read when the lock is contended; the time spent waiting is added to the
+   *  metrics and taken off 'timeout'.
+   *
+   *  @param[in]  lockable  Anything with try_lock_for()
+   *  @param[in]  timeout   Milliseconds to wait or WaitForever, less the time waited on return
+   *  @return bool          True if the lock was taken
+   */
+  template<typename T>
+  static bool waitForLock( T &lockable, size_t &timeout );
+
+  /**
+   *  Writes the metrics report to one sink. The caller must not hold the sink
+   *  lock.
+   *
+   *  @param[in]  sink      Where the report goes
+   *  @return void
+   */
+  static void writeMetrics( SinkInterface *const sink );
+
+  /**
+   *  Writes the periodic metrics report if one is due
+   *
+   *  @return void
+   */
+  static void serviceMetricsDump();
+
+#if ( ULOG_ENABLE_COALESCING == 1 )
+  /**
+   *  Logs the "last message repeated N times" summary for a sink if it dropped
+   *  any repeats since the last one. The caller must hold the sink lock.
+   *
+   *  @param[in]  sink      The sink to check
+   *  @param[in]  tick      Timestamp to give the summary
+   *  @return void
+   */
+  static void emitRepeatSummary( SinkInterface *const sink, const Tick tick );
+
+  /**
+   *  Emits the summaries of sinks whose coalescing window closed without any
+   *  further messages arriving to trigger them.
+   *
+   *  @param[in]  wait      Block on busy sinks instead of skipping them
+   *  @return void
+   */
+  static void sweepRepeatSummaries( const bool wait );
+
+  /**
+   *  Sweeps for closed coalescing windows at most once per window, so the
+   *  logging path finishes repeat runs without a background thread.
+   *
+   *  @param[in]  now       Current time in ms
+   *  @return void
+   */
+  static void serviceRepeatSummaries( const size_t now );
+
+  static std::atomic<size_t> repeatSweepDue( 0 ); /**< Time of the next sweep in ms */
+#endif /* ULOG_ENABLE_COALESCING */
+
+  /**
+   *  A single message waiting in the asynchronous queue or a delivery queue
+   */
+  struct AsyncMessage
+  {
+    RecordInfo info;
+    size_t length;
+    std::array<uint8_t, ULOG_MAX_SNPRINTF_BUFFER_LENGTH> data;
+  };
+
+#if ( ULOG_ENABLE_ASYNC_MODE == 1 )
+  static Queue::MPMCRing<AsyncMessage, ULOG_ASYNC_QUEUE_CAPACITY> asyncQueue;
+  static std::atomic<size_t> asyncQueuedCount( 0 );    /**< Messages successfully queued, ever */
+  static std::atomic<size_t> asyncDeliveredCount( 0 ); /**< Messages handed to the sinks, ever */
+  static std::atomic<bool> asyncDrainActive( false );  /**< A drain thread is currently running */
+  static std::atomic<bool> asyncDrainStop( false );    /**< Requests the drain thread to exit */
+  static std::atomic<size_t> asyncDroppedCount( 0 );  /**< Messages turned away by a full queue, ever */
+
+  /**
+   *  Delivers everything currently in the asynchronous queue to the sinks
+   *
+   *  @return size_t    Number of messages delivered
+   */
+  static size_t drainAsyncQueue();
+
+  /**
+   *  Sequence number for a record entering the asynchronous queue
+   *
+   *  @return uint32_t
+   */
+  static uint32_t queuedSequence();
+
+#if ( ULOG_ASYNC_PER_THREAD_QUEUES == 1 )
+  static constexpr Tick IdleTick = std::numeric_limits<Tick>::max(); /**< No record is being written */
+
+  /**
+   *  Queue owned by one producer thread. The owner is the only writer of the
+   *  ring and of the bookkeeping next to it, which the drain only reads, so the
+   *  producer's cache lines stay on its own core. When a thread exits, the next
+   *  thread to claim the queue carries on where it left off, so records still
+   *  waiting in it are unaffected.
+   */
+  struct ProducerQueue
+  {
+    Queue::SPSCRing<AsyncMessage, ULOG_ASYNC_THREAD_QUEUE_CAPACITY> ring;
+
+    alignas( Queue::CacheLineSize ) std::atomic<Tick> pending; /**< No record still being written is older than this */
+    std::atomic<size_t> queued;                                 /**< Messages published, ever */
+    Tick lastTick;                                              /**< Tick of the newest record started */
+    size_t writers;                                             /**< Records claimed but not yet published */
+
+    alignas( Queue::CacheLineSize ) std::atomic<bool> owned; /**< Claimed by a live thread */
+
+    ProducerQueue() : pending( IdleTick ), queued( 0 ), lastTick( 0 ), writers( 0 ), owned( false )
+    {
+    }
+  };
+
+  /**
+   *  The calling thread's claim on a ProducerQueue, handed back when the
+   *  thread exits
+   */
+  struct ProducerLease
+  {
+    ProducerQueue *queue = nullptr;
+
+    ~ProducerLease()
+    {
+      if ( queue )
+      {
+        queue->owned.store( false, std::memory_order_release );
+        queue = nullptr;
+      }
+    }
+  };
+
+  static std::array<ProducerQueue, ULOG_ASYNC_MAX_PRODUCERS> producerQueues;
+  static thread_local ProducerLease producerLease;
+  static std::atomic_flag asyncConsumerBusy = ATOMIC_FLAG_INIT; /**< The rings only allow one consumer at a time */
+  static AsyncMessage asyncStaged;                              /**< Oldest shared queue entry, waiting its turn */
+  static bool asyncStagedValid = false;
+
+  /**
+   *  Gets the calling thread's queue, claiming a free one on first use
+   *
+   *  @return ProducerQueue *   nullptr if every queue is taken
+   */
+  static ProducerQueue *producerQueue();
+
+  /**
+   *  Marks the start of a record on the calling thread's queue and takes its
+   *  timestamp. Every beginProducerWrite() needs an endProducerWrite().
+   *
+   *  @param[in]  queue     The calling thread's queue
+   *  @return Tick          Timestamp for the record
+   */
+  static Tick beginProducerWrite( ProducerQueue *const queue );
+
+  /**
+   *  Marks a record started by beginProducerWrite() as published or abandoned
+   *
+   *  @param[in]  queue     The calling thread's queue
+   *  @return void
+   */
+  static void endProducerWrite( ProducerQueue *const queue );
+
+  /**
+   *  K-way merge of the per thread queues and the shared queue, oldest record
+   *  first by timestamp
+   *
+   *  @param[in]  everything  Ignore records still being written and take all
+   *                          that is published, for panicFlush()
+   *  @param[in]  deliver     Callable of the form void( AsyncMessage & )
+   *  @return size_t          Number of messages taken
+   */
+  template<typename Deliver>
+  static size_t mergeAsyncQueues( const bool everything, Deliver &&deliver );
+#endif /* ULOG_ASYNC_PER_THREAD_QUEUES */
+
+  /**
+   *  A claimed asynchronous queue cell, waiting to be filled and published
+   */
+  struct QueueClaim
+  {
+    AsyncMessage *entry;
+    size_t ticket;
+#if ( ULOG_ASYNC_PER_THREAD_QUEUES == 1 )
+    ProducerQueue *queue; /**< Owning per thread queue, nullptr for the shared queue */
+#endif
+  };
+
+  /**
+   *  Claims a cell for a new record from the calling thread's queue, or the
+   *  shared queue, and takes the record's timestamp. A full queue fails the
+   *  claim except for FATAL, which waits for room.
+   *
+   *  @param[in]  level     The severity level of the record
+   *  @param[out] tick      Timestamp for the record
+   *  @param[out] claim     The claimed cell
+   *  @return bool          False if the record was dropped
+   */
+  static bool claimQueueEntry( const Level level, Tick &tick, QueueClaim &claim );
+
+  /**
+   *  Hands a filled cell from claimQueueEntry() to the drain
+   *
+   *  @param[in]  claim     The claimed cell
+   *  @return void
+   */
+  static void publishQueueEntry( const QueueClaim &claim );
+
+  /**
+   *  Number of messages ever published to the asynchronous queues
+   *
+   *  @return size_t
+   */
+  static size_t asyncQueuedTotal();
+#endif /* ULOG_ENABLE_ASYNC_MODE */
+
+#if ( ULOG_ENABLE_DELIVERY_WORKERS == 1 )
+  /**
+   *  Queue feeding one sink registered with CFG_DELIVERY_QUEUED or
+   *  CFG_DELIVERY_DEDICATED. Any thread may push. Consumers hold 'busy' so
+   *  the sink still sees its messages one at a time and in order.
+   */
+  struct DeliveryQueue
+  {
+    Queue::MPMCRing<AsyncMessage, ULOG_DELIVERY_QUEUE_CAPACITY> ring;
+    std::atomic<SinkInterface *> sink{ nullptr }; /**< Sink being fed, nullptr while the queue is unused */
+    std::atomic<bool> dedicated{ false };         /**< Only served by the sink's own worker */
+    std::atomic<size_t> workers{ 0 };             /**< Dedicated workers attached to the queue */
+    std::atomic_flag busy = ATOMIC_FLAG_INIT;     /**< Held while consuming */
+    std::atomic<size_t> queued{ 0 };              /**< Messages pushed, ever */
+    std::atomic<size_t> delivered{ 0 };           /**< Messages consumed, ever */
+  };
+
+  static std::array<DeliveryQueue, ULOG_MAX_DELIVERY_QUEUES> deliveryQueues;
+  static std::array<DeliveryQueue *, ULOG_MAX_REGISTERABLE_SINKS> registryQueues; /**< Queue of each sinkRegistry entry */
+  static std::atomic<size_t> deliveryWorkersActive( 0 );                        /**< Delivery workers currently running */
+  static std::atomic<size_t> deliveryPoolWorkers( 0 );                          /**< Of those, the ones serving shared queues */
+  static std::atomic<bool> deliveryWorkersStop( false );                        /**< Requests the workers to exit */
+
+  /**
+   *  Queues a message for a sink. A full queue gets the sink's backpressure
+   *  policy, waiting on the workers (or doing their work if none serves this
+   *  queue) for as long as the policy allows.
+   *
+   *  @param[in]  queue     The sink's delivery queue
+   *  @param[in]  sink      The sink
+   *  @param[in]  info      Level, timestamp and origin of the message
+   *  @param[in]  message   Raw byte message to be logged
+   *  @param[in]  length    Length of the message
+   *  @return Result        RESULT_FULL if the message was dropped
+   */
+  static Result enqueueDelivery( DeliveryQueue *const queue, SinkInterface *const sink, const RecordInfo &info,
+                                 const void *const message, const size_t length );
+
+  /**
+   *  Delivers up to a queue's capacity of messages to its sink, unless
+   *  someone else is already consuming it
+   *
+   *  @param[in]  queue     The queue to service
+   *  @return size_t        Number of messages taken
+   */
+  static size_t serviceDeliveryQueue( DeliveryQueue &queue );
+
+  /**
+   *  Whether a running worker serves a queue: its dedicated worker, or for
+   *  the rest, any pool worker
+   *
+   *  @param[in]  queue     The queue to check
+   *  @return bool
+   */
+  static bool deliveryQueueServed( const DeliveryQueue &queue );
+
+  /**
+   *  Delivers messages from a queue to its sink. The caller must hold 'busy'.
+   *
+   *  @param[in]  queue     The queue to consume
+   *  @param[in]  limit     Most messages to take
+   *  @return size_t        Number of messages taken
+   */
+  static size_t deliverQueued( DeliveryQueue &queue, const size_t limit );
+
+  /**
+   *  Finds a delivery queue no sink is using. The caller must hold the
+   *  registry lock.
+   *
+   *  @return DeliveryQueue *   nullptr if all are in use
+   */
+  static DeliveryQueue *freeDeliveryQueue();
+
+  /**
+   *  Takes a removed sink off its delivery queue, first delivering whatever
+   *  is still waiting in it. The caller must hold the registry lock, and the
+   *  sink must already be out of the published snapshot.
+   *
+   *  @param[in]  queue     The removed sink's queue
+   *  @return void
+   */
+  static void retireDeliveryQueue( DeliveryQueue &queue );
+#endif /* ULOG_ENABLE_DELIVERY_WORKERS */
+
+  void initialize()
+  {
+    Chimera::Thread::LockGuard x( threadLock );
+
+    if ( !uLogInitialized )
+    {
+      sinkRegistry.fill( nullptr );
+      publishSnapshot();
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+      /*------------------------------------------------
+      Hosts know the wall clock time already. Embedded
+      targets calibrate once their RTC has been set.
+      ------------------------------------------------*/
+      timespec wall;
+      clock_gettime( CLOCK_REALTIME, &wall );
+      calibrateTicks( static_cast<uint64_t>( wall.tv_sec ) * 1000000000ull + static_cast<uint64_t>( wall.tv_nsec ) );
+#endif
+
+      uLogInitialized = true;
+    }
+  }
+
+  Result setGlobalLogLevel( const Level level )
+  {
+    globalLogLevel = level;
+    levelsChanged();
+    return Result::RESULT_SUCCESS;
+  }
+
+  Result registerSink( SinkHandle &sink, const uLog::Config options )
+  {
+    constexpr size_t invalidIndex = std::numeric_limits<size_t>::max();
+
+    /*------------------------------------------------
+    From inside a sink, or with a Reservation open, the
+    publish would wait for this very thread to let go
+    ------------------------------------------------*/
+    if ( registryPinned() )
+    {
+      return Result::RESULT_LOCKED;
+    }
+
+    Chimera::Thread::TimedLockGuard x( threadLock );
+    size_t timeout        = defaultLockTimeout;
+    size_t nullIndex      = invalidIndex;           /* First index that doesn't have a sink registered */
+    bool sinkIsRegistered = false;                  /* Indicates if the sink we are registering already exists */
+    bool registryIsFull   = true;                   /* Is the registry full of sinks? */
+    auto result           = Result::RESULT_SUCCESS; /* Function return code */
+    const bool queued     = options & ( CFG_DELIVERY_QUEUED | CFG_DELIVERY_DEDICATED );
+#if ( ULOG_ENABLE_DELIVERY_WORKERS == 1 )
+    DeliveryQueue *queue  = nullptr;                /* Delivery queue for the sink, if it asked for one */
+#endif
+
+    if ( waitForLock( x, timeout ) )
+    {
+      /*------------------------------------------------
+      Check if the sink already is registered as well as
+      an empty slot to insert the new sink.
+      ------------------------------------------------*/
+      for ( size_t i = 0; i < sinkRegistry.size(); i++ )
+      {
+        /* Did we find the first location that is free? */
+        if ( ( nullIndex == invalidIndex ) && ( sinkRegistry[ i ] == nullptr ) )
+        {
+          nullIndex = i;
+          registryIsFull = false;
+        }
+
+        /* Does the sink already exist in the registry? */
+        if ( sinkRegistry[ i ] == sink )
+        {
+          sinkIsRegistered = true;
+          registryIsFull = false;
+          result = Result::RESULT_SUCCESS;
+          break;
+        }
+      }
+
+      /*------------------------------------------------
+      Perform the registration
+      ------------------------------------------------*/
+      if ( !sinkIsRegistered )
+      {
+        if ( registryIsFull )
+        {
+          result = Result::RESULT_FULL;
+        }
+#if ( ULOG_ENABLE_DELIVERY_WORKERS == 1 )
+        else if ( queued && !( queue = freeDeliveryQueue() ) )
+        {
+          result = Result::RESULT_FULL;
+        }
+#else
+        else if ( queued )
+        {
+          result = Result::RESULT_FAIL;
+        }
+#endif /* ULOG_ENABLE_DELIVERY_WORKERS */
+        else if ( sink->open() != Result::RESULT_SUCCESS )
+        {
+          result = Result::RESULT_FAIL;
+        }
+        else
+        {
+          /*------------------------------------------------
+          Binary streams open with the tick calibration so a
+          decoder can turn record ticks into wall time.
+          ------------------------------------------------*/
+          if ( sink->getRecordFormat() == RecordFormat::BINARY )
+          {
+            const TickCalibration &cal = getTickCalibration();
+            const uint64_t payload[ 3 ] = { cal.hz, cal.tick, cal.unixNs };
+            const RecordInfo info       = { RecordType::CALIBRATION, Level::LVL_MAX, 0,
+                                            recordSequence.fetch_add( 1, std::memory_order_relaxed ), readTick() };
+
+            sink->lock();
+            deliver( sinkPointer( sink ), info, payload, sizeof( payload ) );
+            sink->unlock();
+          }
+
+#if ( ULOG_ENABLE_DELIVERY_WORKERS == 1 )
+          if ( queue )
+          {
+            queue->dedicated.store( options & CFG_DELIVERY_DEDICATED, std::memory_order_relaxed );
+            queue->sink.store( sinkPointer( sink ), std::memory_order_release );
+          }
+
+          registryQueues[ nullIndex ] = queue;
+#endif
+          sinkRegistry[ nullIndex ] = sink;
+          publishSnapshot();
+        }
+      }
+    }
+
+    return result;
+  }
+
+  Result removeSink( SinkHandle &sink )
+  {
+    /*------------------------------------------------
+    From inside a sink, or with a Reservation open, the
+    publish would wait for this very thread to let go
+    ------------------------------------------------*/
+    if ( registryPinned() )
+    {
+      return Result::RESULT_LOCKED;
+    }
+
+    Result result  = Result::RESULT_LOCKED;
+    size_t timeout = defaultLockTimeout;
+    Chimera::Thread::TimedLockGuard x( threadLock );
+
+    if ( waitForLock( x, timeout ) )
+    {
+      /*------------------------------------------------
+      Pull the sink(s) out of the registry first and wait
+      for the dispatch path to let go before closing.
+      ------------------------------------------------*/
+      std::array<SinkHandle, ULOG_MAX_REGISTERABLE_SINKS> removed{};
+
+      auto index = getSinkOffsetIndex( sink );
+      if ( index < sinkRegistry.size() )
+      {
+        removed[ index ] = sinkRegistry[ index ];
+        sinkRegistry[ index ] = nullptr;
+        result = Result::RESULT_SUCCESS;
+      }
+      else if ( sink == nullptr )
+      {
+        removed = sinkRegistry;
+        sinkRegistry.fill( nullptr );
+        result = Result::RESULT_SUCCESS;
+      }
+
+      publishSnapshot();
+
+#if ( ULOG_ENABLE_DELIVERY_WORKERS == 1 )
+      /*------------------------------------------------
+      Nothing new can reach the queues now. Let them run
+      dry into their sinks before the sinks are closed.
+      ------------------------------------------------*/
+      for ( size_t i = 0; i < removed.size(); i++ )
+      {
+        if ( removed[ i ] && registryQueues[ i ] )
+        {
+          retireDeliveryQueue( *registryQueues[ i ] );
+          registryQueues[ i ] = nullptr;
+        }
+      }
+#endif /* ULOG_ENABLE_DELIVERY_WORKERS */
+
+      /*------------------------------------------------
+      A Reservation holds the sink lock, not the snapshot,
+      so wait for it to commit before closing
+      ------------------------------------------------*/
+      for ( auto &handle : removed )
+      {
+        if ( handle )
+        {
+          handle->lock();
+          handle->close();
+          handle->unlock();
+          handle = nullptr;
+        }
+      }
+    }
+
+    return result;
+  }
+
+  Result setRootSink( SinkHandle &sink )
+  {
+    Result result  = Result::RESULT_LOCKED;
+    size_t timeout = defaultLockTimeout;
+    Chimera::Thread::TimedLockGuard x( threadLock );
+
+    if ( waitForLock( x, timeout ) )
+    {
+#if ( ULOG_STATIC_SINK_STORAGE == 1 )
+      globalRootSink.store( sink, std::memory_order_release );
+#else
+      std::atomic_store( &globalRootSink, sink );
+#endif
+      result = Result::RESULT_SUCCESS;
+    }
+
+    return result;
+  }
+
+  SinkHandle getRootSink()
+  {
+    /*------------------------------------------------
+    Hand out a copy: a shared handle keeps the sink alive
+    for the caller even if setRootSink() replaces it
+    ------------------------------------------------*/
+#if ( ULOG_STATIC_SINK_STORAGE == 1 )
+    return globalRootSink.load( std::memory_order_acquire );
+#else
+    return std::atomic_load( &globalRootSink );
+#endif
+  }
+
+  size_t getSinkOffsetIndex( const SinkHandle &sinkHandle )
+  {
+    if ( sinkHandle == nullptr )
+    {
+      return std::numeric_limits<size_t>::max();
+    }
+
+    for ( size_t i = 0; i < sinkRegistry.size(); i++ )
+    {
+      if ( sinkRegistry[ i ] == sinkHandle )
+      {
+        return i;
+      }
+    }
+
+    return std::numeric_limits<size_t>::max();
+  }
+
+  void publishSnapshot()
+  {
+    const size_t current = activeSnapshot.load( std::memory_order_relaxed );
+    const size_t next    = current ^ 1u;
+
+    /*------------------------------------------------
+    A reader may still be backing out of the spare buffer
+    after losing a race with the previous publish.
+    ------------------------------------------------*/
+    while ( snapshotReaders[ next ].load( std::memory_order_seq_cst ) )
+    {
+      Chimera::delayMilliseconds( 1 );
+    }
+
+    /*------------------------------------------------
+    Compact the registry
+    ------------------------------------------------*/
+    SinkSnapshot &snapshot = snapshotBuffers[ next ];
+
+    snapshot.count = 0;
+    for ( size_t i = 0; i < sinkRegistry.size(); i++ )
+    {
+      const SinkHandle &handle = sinkRegistry[ i ];
+
+      if ( handle )
+      {
+#if ( ULOG_ENABLE_DELIVERY_WORKERS == 1 )
+        snapshot.queues[ snapshot.count ] = registryQueues[ i ];
+#endif
+        snapshot.sinks[ snapshot.count++ ] = sinkPointer( handle );
+      }
+    }
+
+    activeSnapshot.store( next, std::memory_order_seq_cst );
+    levelsChanged();
+
+    /*------------------------------------------------
+    Wait out anyone still walking the old snapshot
+    ------------------------------------------------*/
+    while ( snapshotReaders[ current ].load( std::memory_order_seq_cst ) )
+    {
+      Chimera::delayMilliseconds( 1 );
+    }
+  }
+
+  static void refreshModuleMasks()
+  {
+    while ( true )
+    {
+      const size_t generation = levelGeneration.load();
+
+      /*------------------------------------------------
+      Lowest level that any enabled sink is interested in
+      ------------------------------------------------*/
+      Level sinkFloor = Level::LVL_MAX;
+      {
+        SnapshotReader snapshot;
+
+        for ( size_t i = 0; i < snapshot->count; i++ )
+        {
+          SinkInterface *const sink = snapshot->sinks[ i ];
+
+          if ( sink->isEnabled() )
+          {
+            sinkFloor = std::min( sinkFloor, sink->getLogLevel() );
+          }
+        }
+      }
+
+      const Level global = globalLogLevel.load();
+
+      for ( size_t i = 0; i < moduleMasks.size(); i++ )
+      {
+        const uint8_t custom  = moduleOverrides[ i ].load();
+        const Level threshold = ( custom == NoOverride ) ? global : static_cast<Level>( custom - 1 );
+        const size_t floor     = static_cast<size_t>( std::max( threshold, sinkFloor ) );
+
+        moduleMasks[ i ].store( static_cast<uint8_t>( ( AllLevels << floor ) & AllLevels ), std::memory_order_relaxed );
+      }
+
+      /*------------------------------------------------
+      Another thread changed an input while this one was
+      storing, possibly over its newer masks. Go again.
+      ------------------------------------------------*/
+      if ( levelGeneration.load() == generation )
+      {
+        return;
+      }
+    }
+  }
+
+  static void levelsChanged()
+  {
+    levelGeneration.fetch_add( 1 );
+    refreshModuleMasks();
+  }
+
+  Result setModuleLevel( const ModuleId module, const Level level )
+  {
+    if ( module >= ULOG_MAX_MODULES )
+    {
+      return Result::RESULT_FAIL;
+    }
+    else if ( level > Level::LVL_MAX )
+    {
+      return Result::RESULT_INVALID_LEVEL;
+    }
+
+    moduleOverrides[ module ].store( static_cast<uint8_t>( static_cast<size_t>( level ) + 1 ) );
+    levelsChanged();
+    return Result::RESULT_SUCCESS;
+  }
+
+  Result clearModuleLevel( const ModuleId module )
+  {
+    if ( module >= ULOG_MAX_MODULES )
+    {
+      return Result::RESULT_FAIL;
+    }
+
+    moduleOverrides[ module ].store( NoOverride );
+    levelsChanged();
+    return Result::RESULT_SUCCESS;
+  }
+
+  void refreshSinkLevels()
+  {
+    /*------------------------------------------------
+    Dispatch reads each sink's level live, so only the
+    filter masks need updating. No lock and no publish:
+    a sink may call this from inside its own log().
+    ------------------------------------------------*/
+    levelsChanged();
+  }
+
+  Result log( const Level level, const void *const message, const size_t length )
+  {
+    return logRecord( RecordType::TEXT, DefaultModule, level, message, length );
+  }
+
+  Result log( const ModuleId module, const Level level, const void *const message, const size_t length )
+  {
+    return logRecord( RecordType::TEXT, module, level, message, length );
+  }
+
+  Result logRecord( const RecordType type, const ModuleId module, const Level level, const void *const message,
+                    const size_t length )
+  {
+#if ( ULOG_ENABLE_ASYNC_MODE == 1 )
+    /*------------------------------------------------
+    Input boundary checking. The registry lock is never
+    taken here so that a slow sink can't stall callers.
+    ------------------------------------------------*/
+    if ( ( level > Level::LVL_MAX ) || !message || !length )
+    {
+      return Result::RESULT_FAIL;
+    }
+    else if ( !moduleAccepts( module, level ) )
+    {
+      countMetric( metricFiltered[ static_cast<size_t>( level ) ] );
+      return Result::RESULT_FAIL;
+    }
+    else if ( length > ULOG_MAX_SNPRINTF_BUFFER_LENGTH )
+    {
+      return Result::RESULT_FAIL_MSG_TOO_LONG;
+    }
+
+    countMetric( metricLogged[ static_cast<size_t>( level ) ] );
+
+    /*------------------------------------------------
+    Copy the message into the queue for the drain thread.
+    The tick is taken now, not when it is delivered.
+    ------------------------------------------------*/
+    RecordInfo info = { type, level, module, 0, 0 };
+    QueueClaim claim;
+
+    if ( !claimQueueEntry( level, info.tick, claim ) )
+    {
+      return Result::RESULT_FULL;
+    }
+
+    info.sequence       = queuedSequence();
+    claim.entry->info   = info;
+    claim.entry->length = length;
+    memcpy( claim.entry->data.data(), message, length );
+    publishQueueEntry( claim );
+#else
+    /*------------------------------------------------
+    Input boundary checking
+    ------------------------------------------------*/
+    if ( ( level > Level::LVL_MAX ) || !message || !length )
+    {
+      return Result::RESULT_FAIL;
+    }
+    else if ( !moduleAccepts( module, level ) )
+    {
+      countMetric( metricFiltered[ static_cast<size_t>( level ) ] );
+      return Result::RESULT_FAIL;
+    }
+
+    countMetric( metricLogged[ static_cast<size_t>( level ) ] );
+
+    const RecordInfo info = { type, level, module, recordSequence.fetch_add( 1, std::memory_order_relaxed ), readTick() };
+    const Result result   = dispatch( info, message, length );
+
+    serviceMetricsDump();
+#endif /* ULOG_ENABLE_ASYNC_MODE */
+
+#if ( ULOG_FLUSH_ON_FATAL == 1 )
+    /*------------------------------------------------
+    The process may not live long enough for buffered
+    output to go out on its own. Skipped on threads the
+    flush would wait on.
+    ------------------------------------------------*/
+    if ( ( level == Level::LVL_FATAL ) && flushAllowed() )
+    {
+      flush();
+    }
+#endif /* ULOG_FLUSH_ON_FATAL */
+
+#if ( ULOG_ENABLE_ASYNC_MODE == 1 )
+    return Result::RESULT_SUCCESS;
+#else
+    return result;
+#endif /* ULOG_ENABLE_ASYNC_MODE */
+  }
+
+  size_t getQueueDropCount()
+  {
+#if ( ULOG_ENABLE_ASYNC_MODE == 1 )
+    return asyncDroppedCount.load( std::memory_order_relaxed );
+#else
+    return 0;
+#endif /* ULOG_ENABLE_ASYNC_MODE */
+  }
+
+  bool isLevelEnabled( const Level level )
+  {
+    return isLevelEnabled( DefaultModule, level );
+  }
+
+  bool isLevelEnabled( const ModuleId module, const Level level )
+  {
+    if ( level > Level::LVL_MAX )
+    {
+      return false;
+    }
+    else if ( !moduleAccepts( module, level ) )
+    {
+      countMetric( metricFiltered[ static_cast<size_t>( level ) ] );
+      return false;
+    }
+
+    return true;
+  }
+
+  Result dispatch( const RecordInfo &info, const void *const message, const size_t length )
+  {
+    const Level level = info.level;
+    Result result     = Result::RESULT_SUCCESS;
+
+    if ( !moduleAccepts( info.module, level ) )
+    {
+      return Result::RESULT_FAIL;
+    }
+
+#if ( ULOG_ENABLE_COALESCING == 1 )
+    const uint64_t hash = Coalescer::hash( message, length );
+    const size_t now    = Chimera::millis();
+#else
+    const uint64_t hash = 0;
+    const size_t now    = 0;
+#endif
+
+    /*------------------------------------------------
+    Process the message through each sink, or leave it
+    in the sink's queue for a delivery worker
+    ------------------------------------------------*/
+    SnapshotReader snapshot;
+
+    for ( size_t i = 0; i < snapshot->count; i++ )
+    {
+      SinkInterface *const sink = snapshot->sinks[ i ];
+      Result delivered          = Result::RESULT_SUCCESS;
+
+      if ( level < sink->getLogLevel() )
+      {
+        continue;
+      }
+      else if ( !formatAccepts( sink, info ) )
+      {
+        countMetric( metricFiltered[ static_cast<size_t>( level ) ] );
+        continue;
+      }
+
+#if ( ULOG_ENABLE_DELIVERY_WORKERS == 1 )
+      if ( DeliveryQueue *const queue = snapshot->queues[ i ]; queue )
+      {
+        delivered = enqueueDelivery( queue, sink, info, message, length );
+      }
+      else
+#endif /* ULOG_ENABLE_DELIVERY_WORKERS */
+      {
+        delivered = deliverToSink( sink, info, message, length, hash, now );
+      }
+
+      if ( delivered != Result::RESULT_SUCCESS )
+      {
+        result = delivered;
+      }
+    }
+
+#if ( ULOG_ENABLE_COALESCING == 1 )
+    /*-------------------------------------------------
+    Close out repeat runs on sinks that aren't hearing
+    anything new. Sync mode has no idle thread to do it.
+    -------------------------------------------------*/
+    serviceRepeatSummaries( now );
+#endif
+
+    return result;
+  }
+
+  static Result deliverToSink( SinkInterface *const sink, const RecordInfo &info, const void *const message,
+                               const size_t length, const uint64_t hash, const size_t now )
+  {
+    const Level level = info.level;
+
+    /*------------------------------------------------
+    A sink that can't take the message applies its
+    backpressure policy and the loss is counted against
+    it
+    ------------------------------------------------*/
+    const BackpressurePolicy policy = sink->getBackpressure( level );
+    bool ready                      = acquireSink( sink, policy, length );
+
+    if ( !ready && ( policy.action == Backpressure::SPILL ) && spillRecord( sink, policy, info, message, length ) )
+    {
+      sink->countSpill();
+      return Result::RESULT_SUCCESS;
+    }
+    else if ( !ready && ( level == Level::LVL_FATAL ) )
+    {
+      ready = acquireSink( sink, { Backpressure::BLOCK, WaitForever }, length );
+    }
+
+    if ( !ready )
+    {
+      sink->countDrops( level, 1 );
+      return Result::RESULT_FULL;
+    }
+
+    /*------------------------------------------------
+    The sink's own result isn't reported, only a message
+    it could never be given
+    ------------------------------------------------*/
+    Result result = Result::RESULT_SUCCESS;
+    auto write    = [ & ]() {
+      if ( deliver( sink, info, message, length ) == Result::RESULT_FAIL_MSG_TOO_LONG )
+      {
+        result = Result::RESULT_FAIL_MSG_TOO_LONG;
+      }
+    };
+
+#if ( ULOG_ENABLE_COALESCING == 1 )
+    /*------------------------------------------------
+    Drop exact repeats inside the window. Anything else
+    first reports how many repeats the sink swallowed.
+    ------------------------------------------------*/
+    Coalescer &coalescer = sink->getCoalescer();
+    if ( !coalescer.absorb( info.module, level, length, hash, now ) )
+    {
+      emitRepeatSummary( sink, info.tick );
+      write();
+      coalescer.track( info.module, level, length, hash, now );
+    }
+#else
+    ( void )hash;
+    ( void )now;
+    write();
+#endif /* ULOG_ENABLE_COALESCING */
+    sink->unlock();
+
+    return result;
+  }
+
+  static bool acquireSink( SinkInterface *const sink, const BackpressurePolicy &policy, const size_t length )
+  {
+    size_t timeout = policy.waitMs;
+
+    if ( !waitForLock( *sink, timeout ) )
+    {
+      return false;
+    }
+
+    /*------------------------------------------------
+    Time spent on the lock came out of the wait for
+    space. Binary sinks also need room for the header,
+    and a coalescing sink may owe a summary first.
+    ------------------------------------------------*/
+    size_t needed = length;
+
+    if ( sink->getRecordFormat() == RecordFormat::BINARY )
+    {
+      needed += RecordHeaderSize;
+    }
+
+#if ( ULOG_ENABLE_COALESCING == 1 )
+    if ( sink->getCoalescer().pending() )
+    {
+      needed += RepeatSummaryLength + RecordHeaderSize;
+    }
+#endif
+
+    if ( sink->waitForSpace( needed, timeout ) )
+    {
+      return true;
+    }
+    else if ( ( policy.action == Backpressure::DROP_OLDEST ) && sink->discardOldest( needed ) )
+    {
+      return true;
+    }
+
+    sink->unlock();
+    return false;
+  }
+
+  static bool spillRecord( SinkInterface *const sink, const BackpressurePolicy &policy, const RecordInfo &info,
+                           const void *const message, const size_t length )
+  {
+    SinkInterface *const spill = sink->getSpillSink();
+
+    if ( !spill || !acquireSink( spill, { Backpressure::DROP_NEWEST, policy.waitMs }, length ) )
+    {
+      return false;
+    }
+
+    const Result result = deliver( spill, info, message, length );
+    spill->unlock();
+
+    return result == Result::RESULT_SUCCESS;
+  }
+
+  static Result deliver( SinkInterface *const sink, const RecordInfo &info, const void *const message, const size_t length )
+  {
+    const void *payload  = message;
+    size_t payloadLength = length;
+
+    /*------------------------------------------------
+    Reached through a spill sink, which may not share
+    the overloaded sink's format
+    ------------------------------------------------*/
+    if ( !formatAccepts( sink, info ) )
+    {
+      return Result::RESULT_FAIL;
+    }
+
+    /*------------------------------------------------
+    A payload too long for the record buffer is refused
+    and counted rather than written cut short
+    ------------------------------------------------*/
+    std::array<uint8_t, RecordMaxLength> record;
+
+    if ( sink->getRecordFormat() == RecordFormat::BINARY )
+    {
+      if ( length > ( record.size() - RecordHeaderSize ) )
+      {
+        sink->countDrops( info.level, 1 );
+        return Result::RESULT_FAIL_MSG_TOO_LONG;
+      }
+
+      payloadLength = encodeRecord( info, message, length, record.data(), record.size() );
+      payload       = record.data();
+    }
+
+#if ( ULOG_ENABLE_METRICS == 1 )
+    const Tick start    = readTick();
+    const Result result = sink->log( info.level, info.tick, payload, payloadLength );
+
+    sink->getLatency().record( ticksToNanoseconds( readTick() - start ) );
+    return result;
+#else
+    return sink->log( info.level, info.tick, payload, payloadLength );
+#endif /* ULOG_ENABLE_METRICS */
+  }
+
+  template<typename T>
+  static bool waitForLock( T &lockable, size_t &timeout )
+  {
+    if ( lockable.try_lock_for( 0 ) )
+    {
+      return true;
+    }
+    else if ( !timeout )
+    {
+      countMetric( metricLockWaits );
+      countMetric( metricLockTimeouts );
+      return false;
+    }
+
+    const Tick start = readTick();
+    bool locked      = true;
+
+    if ( timeout == WaitForever )
+    {
+      while ( !lockable.try_lock_for( defaultLockTimeout ) )
+      {
+        continue;
+      }
+    }
+    else
+    {
+      locked = lockable.try_lock_for( timeout );
+    }
+
+    const uint64_t waitedNs = ticksToNanoseconds( readTick() - start );
+
+    if ( timeout != WaitForever )
+    {
+      timeout -= static_cast<size_t>( std::min<uint64_t>( waitedNs / 1000000u, timeout ) );
+    }
+
+    countMetric( metricLockWaits );
+    countMetric( metricLockWaitNs, waitedNs );
+    if ( !locked )
+    {
+      countMetric( metricLockTimeouts );
+    }
+
+    return locked;
+  }
+
+#if ( ULOG_ENABLE_COALESCING == 1 )
+  static void emitRepeatSummary( SinkInterface *const sink, const Tick tick )
+  {
+    Coalescer &coalescer   = sink->getCoalescer();
+    const uint32_t repeats = coalescer.takeRepeats();
+
+    if ( repeats )
+    {
+      char summary[ RepeatSummaryLength ];
+      const int length = snprintf( summary, sizeof( summary ), "last message repeated %u times\n", static_cast<unsigned>( repeats ) );
+      const RecordInfo info = { RecordType::TEXT, coalescer.level(), coalescer.module(), recordSequence.fetch_add( 1, std::memory_order_relaxed ), tick };
+      deliver( sink, info, summary, std::min<size_t>( length, sizeof( summary ) - 1 ) );
+    }
+  }
+
+  static void sweepRepeatSummaries( const bool wait )
+  {
+    SnapshotReader snapshot;
+    const size_t now = Chimera::millis();
+
+    for ( size_t i = 0; i < snapshot->count; i++ )
+    {
+      SinkInterface *const sink = snapshot->sinks[ i ];
+
+      /*-------------------------------------------------
+      A busy sink is left for the next sweep rather than
+      stalling whoever is logging
+      -------------------------------------------------*/
+      if ( wait )
+      {
+        sink->lock();
+      }
+      else if ( !sink->try_lock_for( 0 ) )
+      {
+        continue;
+      }
+
+      if ( sink->getCoalescer().expired( now ) )
+      {
+        emitRepeatSummary( sink, readTick() );
+      }
+      sink->unlock();
+    }
+  }
+
+  static void serviceRepeatSummaries( const size_t now )
+  {
+    size_t due = repeatSweepDue.load( std::memory_order_relaxed );
+
+    if ( ( now < due ) ||
+         !repeatSweepDue.compare_exchange_strong( due, now + ULOG_COALESCE_WINDOW_MS, std::memory_order_relaxed ) )
+    {
+      return;
+    }
+
+    sweepRepeatSummaries( false );
+  }
+#endif /* ULOG_ENABLE_COALESCING */
+
+  void getMetrics( Metrics &metrics )
+  {
+    for ( size_t i = 0; i < LevelCount; i++ )
+    {
+      metrics.logged[ i ]   = metricLogged[ i ].load( std::memory_order_relaxed );
+      metrics.filtered[ i ] = metricFiltered[ i ].load( std::memory_order_relaxed );
+    }
+
+    metrics.lockTimeouts = metricLockTimeouts.load( std::memory_order_relaxed );
+    metrics.lockWaits    = metricLockWaits.load( std::memory_order_relaxed );
+    metrics.lockWaitNs   = metricLockWaitNs.load( std::memory_order_relaxed );
+    metrics.queueDrops   = getQueueDropCount();
+  }
+
+  void resetMetrics()
+  {
+    for ( size_t i = 0; i < LevelCount; i++ )
+    {
+      metricLogged[ i ].store( 0, std::memory_order_relaxed );
+      metricFiltered[ i ].store( 0, std::memory_order_relaxed );
+    }
+
+    metricLockTimeouts.store( 0, std::memory_order_relaxed );
+    metricLockWaits.store( 0, std::memory_order_relaxed );
+    metricLockWaitNs.store( 0, std::memory_order_relaxed );
+
+    SnapshotReader snapshot;
+
+    for ( size_t i = 0; i < snapshot->count; i++ )
+    {
+      snapshot->sinks[ i ]->getLatency().reset();
+    }
+  }
+
+  Result dumpMetrics( SinkHandle &sink )
+  {
+    if ( !sink )
+    {
+      return Result::RESULT_FAIL_BAD_SINK;
+    }
+
+    writeMetrics( sinkPointer( sink ) );
+    return Result::RESULT_SUCCESS;
+  }
+
+  Result setMetricsDump( SinkHandle &sink, const size_t intervalMs )
+  {
+    Chimera::Thread::LockGuard x( threadLock );
+
+    metricsDumpDue.store( 0, std::memory_order_relaxed );
+    metricsDumpSink = sink;
+    metricsDumpInterval.store( intervalMs, std::memory_order_relaxed );
+
+    if ( sink && intervalMs )
+    {
+      metricsDumpDue.store( std::max<size_t>( Chimera::millis() + intervalMs, 1 ), std::memory_order_relaxed );
+    }
+
+    return Result::RESULT_SUCCESS;
+  }
+
+  static void writeMetrics( SinkInterface *const sink )
+  {
+    Metrics metrics;
+    getMetrics( metrics );
+
+    /*------------------------------------------------
+    One line for the process, with a count per level,
+    then one per sink
+    ------------------------------------------------*/
+    std::array<char, ULOG_MAX_SNPRINTF_BUFFER_LENGTH> line;
+    size_t used = 0;
+
+    auto append = [ &line, &used ]( const int written ) {
+      used = std::min<size_t>( used + std::max( written, 0 ), line.size() - 1 );
+    };
+
+    auto appendLevels = [ &line, &used, &append ]( const char *const label, const std::array<size_t, LevelCount> &counts ) {
+      append( snprintf( line.data() + used, line.size() - used, "%s", label ) );
+
+      for ( size_t level = 0; level < LevelCount; level++ )
+      {
+        append( snprintf( line.data() + used, line.size() - used, level ? "/%zu" : "%zu", counts[ level ] ) );
+      }
+    };
+
+    appendLevels( "uLog metrics: logged ", metrics.logged );
+    appendLevels( ", filtered ", metrics.filtered );
+    append( snprintf( line.data() + used, line.size() - used,
+                      ", lock waits %zu (%llu us), lock timeouts %zu, queue drops %zu\n", metrics.lockWaits,
+                      static_cast<unsigned long long>( metrics.lockWaitNs / 1000u ), metrics.lockTimeouts, metrics.queueDrops ) );
+
+    sink->lock();
+    RecordInfo info = { RecordType::TEXT, Level::LVL_INFO, DefaultModule, 0, readTick() };
+
+    info.sequence = recordSequence.fetch_add( 1, std::memory_order_relaxed );
+    deliver( sink, info, line.data(), used );
+
+    SnapshotReader snapshot;
+
+    for ( size_t i = 0; i < snapshot->count; i++ )
+    {
+      SinkInterface *const entry    = snapshot->sinks[ i ];
+      const LatencyStats stats      = entry->getLatency().snapshot();
+      const std::string_view name   = entry->getName();
+      const unsigned long long mean = stats.count ? ( stats.totalNs / stats.count ) : 0;
+
+      const int length = snprintf( line.data(), line.size(),
+                                   "uLog sink %zu '%.*s': %zu calls, mean %llu ns, p50 < %llu ns, p99 < %llu ns, max %llu ns, "
+                                   "dropped %zu, spilled %zu\n",
+                                   i, static_cast<int>( name.size() ), name.data(), stats.count, mean,
+                                   static_cast<unsigned long long>( stats.percentileNs( 50 ) ),
+                                   static_cast<unsigned long long>( stats.percentileNs( 99 ) ),
+                                   static_cast<unsigned long long>( stats.maxNs ), entry->getDropCount(), entry->getSpillCount() );
+
+      info.sequence = recordSequence.fetch_add( 1, std::memory_order_relaxed );
+      deliver( sink, info, line.data(), std::min<size_t>( std::max( length, 0 ), line.size() - 1 ) );
+    }
+
+    sink->unlock();
+  }
+
+  static void serviceMetricsDump()
+  {
+#if ( ULOG_ENABLE_METRICS == 1 )
+    size_t due = metricsDumpDue.load( std::memory_order_relaxed );
+
+    if ( !due || ( Chimera::millis() < due ) )
+    {
+      return;
+    }
+
+    /*------------------------------------------------
+    Skip it rather than wait if the registry is busy;
+    the next call tries again
+    ------------------------------------------------*/
+    Chimera::Thread::TimedLockGuard x( threadLock );
+
+    if ( !x.try_lock_for( 0 ) )
+    {
+      return;
+    }
+
+    due = metricsDumpDue.load( std::memory_order_relaxed );
+
+    if ( !due || ( Chimera::millis() < due ) || !metricsDumpSink )
+    {
+      return;
+    }
+
+    metricsDumpDue.store( std::max<size_t>( Chimera::millis() + metricsDumpInterval.load( std::memory_order_relaxed ), 1 ),
+                          std::memory_order_relaxed );
+    writeMetrics( sinkPointer( metricsDumpSink ) );
+#endif /* ULOG_ENABLE_METRICS */
+  }
+
+  Reservation::Reservation( const Level level, const size_t maxBytes ) : Reservation( DefaultModule, level, maxBytes )
+  {
+  }
+
+  Reservation::Reservation( const ModuleId module, const Level level, const size_t maxBytes ) :
+      mTarget( Target::NONE ), mInfo{ RecordType::TEXT, level, module, 0, 0 }, mData( nullptr ), mSize( maxBytes ),
+      mTicket( 0 ), mEntry( nullptr ), mQueue( nullptr ), mSink( nullptr )
+  {
+    if ( ( level > Level::LVL_MAX ) || !maxBytes )
+    {
+      return;
+    }
+    else if ( !moduleAccepts( module, level ) )
+    {
+      countMetric( metricFiltered[ static_cast<size_t>( level ) ] );
+      return;
+    }
+
+    mInfo.tick = readTick();
+
+#if ( ULOG_ENABLE_ASYNC_MODE == 1 )
+    /*------------------------------------------------
+    Write straight into a queue cell. A full queue is
+    handled just like in logRecord().
+    ------------------------------------------------*/
+    if ( maxBytes > ULOG_MAX_SNPRINTF_BUFFER_LENGTH )
+    {
+      return;
+    }
+
+    QueueClaim claim;
+
+    if ( !claimQueueEntry( level, mInfo.tick, claim ) )
+    {
+      return;
+    }
+
+    holdQueueClaim( true );
+
+    mTarget = Target::QUEUE;
+    mTicket = claim.ticket;
+    mEntry  = claim.entry;
+    mData   = claim.entry->data.data();
+#if ( ULOG_ASYNC_PER_THREAD_QUEUES == 1 )
+    mQueue = claim.queue;
+#endif
+#else
+    /*------------------------------------------------
+    When only one sink wants the message, borrow space
+    in its buffer. Once the sink is locked the snapshot
+    is let go, so registry changes on other threads don't
+    wait on the caller; removeSink() takes the sink lock
+    before closing it, which keeps the sink open.
+    ------------------------------------------------*/
+    const size_t ticket          = SnapshotReader::enter();
+    const SinkSnapshot &snapshot = snapshotBuffers[ ticket ];
+    SinkInterface *only          = nullptr;
+    size_t matches               = 0;
+    bool inPlace                 = true;
+
+    for ( size_t i = 0; i < snapshot.count; i++ )
+    {
+      if ( level >= snapshot.sinks[ i ]->getLogLevel() )
+      {
+        only = snapshot.sinks[ i ];
+        matches++;
+
+#if ( ULOG_ENABLE_DELIVERY_WORKERS == 1 )
+        /*------------------------------------------------
+        A queued sink is written by its worker, not here
+        ------------------------------------------------*/
+        inPlace = inPlace && !snapshot.queues[ i ];
+#endif
+      }
+    }
+
+    /*------------------------------------------------
+    A binary record header can't describe a payload past
+    RecordMaxPayload, so larger claims take the scratch
+    route, or fail if they don't fit there either
+    ------------------------------------------------*/
+    const size_t header = ( ( matches == 1 ) && ( only->getRecordFormat() == RecordFormat::BINARY ) ) ? RecordHeaderSize : 0;
+
+    if ( ( matches == 1 ) && inPlace && ( !header || ( maxBytes <= RecordMaxPayload ) ) )
+    {
+      const BackpressurePolicy policy = only->getBackpressure( level );
+      bool ready                      = acquireSink( only, policy, maxBytes );
+
+      if ( !ready && ( level == Level::LVL_FATAL ) )
+      {
+        ready = acquireSink( only, { Backpressure::BLOCK, WaitForever }, maxBytes );
+      }
+
+      if ( ready )
+      {
+#if ( ULOG_ENABLE_COALESCING == 1 )
+        emitRepeatSummary( only, mInfo.tick );
+        only->getCoalescer().forget();
+#endif
+
+        if ( uint8_t *const space = static_cast<uint8_t *>( only->reserve( maxBytes + header ) ); space )
+        {
+          mTarget = Target::SINK;
+          mSink   = only;
+          mData   = space + header;
+
+          pinRegistry();
+          SnapshotReader::leave( ticket );
+          return;
+        }
+
+        only->unlock();
+      }
+      else if ( maxBytes > ScratchBuffer::size() )
+      {
+        only->countDrops( level, 1 );
+      }
+    }
+    else if ( ( matches == 1 ) && inPlace && ( maxBytes > ScratchBuffer::size() ) )
+    {
+      only->countDrops( level, 1 );
+    }
+
+    SnapshotReader::leave( ticket );
+
+    /*------------------------------------------------
+    Otherwise build the message in a scratch buffer and
+    deliver it like log() does, policies and all.
+    ------------------------------------------------*/
+    if ( maxBytes <= ScratchBuffer::size() )
+    {
+      mScratch.emplace();
+
+      if ( mScratch->valid() )
+      {
+        mTarget = Target::SCRATCH;
+        mData   = reinterpret_cast<uint8_t *>( mScratch->data() );
+      }
+    }
+#endif /* ULOG_ENABLE_ASYNC_MODE */
+  }
+
+  Reservation::~Reservation()
+  {
+    release( 0 );
+  }
+
+  Result Reservation::commit( const size_t length )
+  {
+    if ( !valid() )
+    {
+      return Result::RESULT_FAIL;
+    }
+    else if ( length > mSize )
+    {
+      release( 0 );
+      return Result::RESULT_FAIL_MSG_TOO_LONG;
+    }
+
+    if ( length )
+    {
+      countMetric( metricLogged[ static_cast<size_t>( mInfo.level ) ] );
+    }
+
+    const Result result = release( length );
+    serviceMetricsDump();
+    return result;
+  }
+
+  Result Reservation::release( const size_t length )
+  {
+    Result result = Result::RESULT_SUCCESS;
+
+    if ( length && ( mTarget != Target::QUEUE ) )
+    {
+      mInfo.sequence = recordSequence.fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    switch ( mTarget )
+    {
+#if ( ULOG_ENABLE_ASYNC_MODE == 1 )
+      /*------------------------------------------------
+      A claimed cell must be published even if cancelled;
+      the drain thread skips it when it's empty.
+      ------------------------------------------------*/
+      case Target::QUEUE: {
+        QueueClaim claim;
+        claim.entry  = static_cast<AsyncMessage *>( mEntry );
+        claim.ticket = mTicket;
+#if ( ULOG_ASYNC_PER_THREAD_QUEUES == 1 )
+        claim.queue = static_cast<ProducerQueue *>( mQueue );
+#endif
+
+        if ( length )
+        {
+          mInfo.sequence = queuedSequence();
+        }
+
+        claim.entry->info   = mInfo;
+        claim.entry->length = length;
+        publishQueueEntry( claim );
+        holdQueueClaim( false );
+      }
+      break;
+#endif /* ULOG_ENABLE_ASYNC_MODE */
+
+      case Target::SINK: {
+        const size_t header = ( mSink->getRecordFormat() == RecordFormat::BINARY ) ? RecordHeaderSize : 0;
+
+        if ( length && header )
+        {
+          encodeRecordHeader( mInfo, length, mData - header );
+        }
+
+        result = mSink->commit( mInfo.level, length ? ( length + header ) : 0 );
+        mSink->unlock();
+        unpinRegistry();
+      }
+      break;
+
+      case Target::SCRATCH:
+        if ( length )
+        {
+          result = dispatch( mInfo, mData, length );
+        }
+
+        mScratch.reset();
+        break;
+
+      default:
+        break;
+    }
+
+    mTarget = Target::NONE;
+    mData   = nullptr;
+    return result;
+  }
+
+  Result flush()
+  {
+#if ( ULOG_ENABLE_ASYNC_MODE == 1 )
+    /*------------------------------------------------
+    Wait for everything queued up to this point to reach
+    the sinks. Without a drain thread, do the work here.
+    ------------------------------------------------*/
+    const size_t target = asyncQueuedTotal();
+
+    while ( asyncDeliveredCount.load( std::memory_order_acquire ) < target )
+    {
+      if ( !asyncDrainActive.load( std::memory_order_acquire ) )
+      {
+        drainAsyncQueue();
+      }
+      else
+      {
+        Chimera::delayMilliseconds( ULOG_ASYNC_DRAIN_IDLE_MS );
+      }
+    }
+#endif /* ULOG_ENABLE_ASYNC_MODE */
+
+#if ( ULOG_ENABLE_DELIVERY_WORKERS == 1 )
+    /*------------------------------------------------
+    Then for the delivery queues to run dry into their
+    sinks, helping out whenever nobody is consuming
+    ------------------------------------------------*/
+    for ( DeliveryQueue &queue : deliveryQueues )
+    {
+      const size_t target = queue.queued.load( std::memory_order_acquire );
+
+      while ( queue.sink.load( std::memory_order_acquire ) && ( queue.delivered.load( std::memory_order_acquire ) < target ) )
+      {
+        if ( !serviceDeliveryQueue( queue ) )
+        {
+          Chimera::delayMilliseconds( ULOG_DELIVERY_WORKER_IDLE_MS );
+        }
+      }
+    }
+#endif /* ULOG_ENABLE_DELIVERY_WORKERS */
+
+    /*------------------------------------------------
+    Push out anything the sinks themselves are holding
+    ------------------------------------------------*/
+    SnapshotReader snapshot;
+
+    for ( size_t i = 0; i < snapshot->count; i++ )
+    {
+      SinkInterface *const sink = snapshot->sinks[ i ];
+
+      sink->lock();
+#if ( ULOG_ENABLE_COALESCING == 1 )
+      emitRepeatSummary( sink, readTick() );
+#endif
+      sink->flush();
+      sink->unlock();
+    }
+
+    return Result::RESULT_SUCCESS;
+  }
+
+  void panicFlush( const void *const message, const size_t length )
+  {
+    /*------------------------------------------------
+    One shot: a second crash while flushing, or another
+    thread crashing too, must not write everything again
+    ------------------------------------------------*/
+    if ( panicActive.test_and_set( std::memory_order_acq_rel ) )
+    {
+      return;
+    }
+
+    SnapshotReader snapshot;
+
+    /*------------------------------------------------
+    Whatever the sinks hold is older than anything still
+    in the queue, so it goes out first
+    ------------------------------------------------*/
+    for ( size_t i = 0; i < snapshot->count; i++ )
+    {
+      snapshot->sinks[ i ]->panicFlush();
+    }
+
+#if ( ULOG_ENABLE_DELIVERY_WORKERS == 1 )
+    /*------------------------------------------------
+    Then what was waiting on a delivery worker. These
+    are older than anything in the async queue.
+    ------------------------------------------------*/
+    for ( size_t i = 0; i < snapshot->count; i++ )
+    {
+      if ( DeliveryQueue *const queue = snapshot->queues[ i ]; queue )
+      {
+        SinkInterface *const sink = snapshot->sinks[ i ];
+
+        while ( queue->ring.pop( [ sink ]( AsyncMessage &entry ) {
+          if ( entry.length )
+          {
+            panicDeliver( sink, entry.info, entry.data.data(), entry.length );
+          }
+        } ) )
+        {
+          queue->delivered.fetch_add( 1, std::memory_order_release );
+        }
+      }
+    }
+#endif /* ULOG_ENABLE_DELIVERY_WORKERS */
+
+#if ( ULOG_ENABLE_ASYNC_MODE == 1 )
+    /*------------------------------------------------
+    Popping is lock-free. Entries still being written by
+    an interrupted producer stop the walk there.
+    ------------------------------------------------*/
+    auto deliverEntry = [ & ]( AsyncMessage &entry ) {
+      for ( size_t i = 0; entry.length && ( i < snapshot->count ); i++ )
+      {
+        panicDeliver( snapshot->sinks[ i ], entry.info, entry.data.data(), entry.length );
+      }
+    };
+
+#if ( ULOG_ASYNC_PER_THREAD_QUEUES == 1 )
+    /*------------------------------------------------
+    The rings allow one consumer. If the drain was
+    interrupted mid merge, popping here as well would
+    corrupt them, so what it holds is left behind.
+    ------------------------------------------------*/
+    if ( !asyncConsumerBusy.test_and_set( std::memory_order_acquire ) )
+    {
+      mergeAsyncQueues( true, deliverEntry );
+      asyncConsumerBusy.clear( std::memory_order_release );
+    }
+#else
+    while ( asyncQueue.pop( deliverEntry ) )
+    {
+      asyncDeliveredCount.fetch_add( 1, std::memory_order_release );
+    }
+#endif /* ULOG_ASYNC_PER_THREAD_QUEUES */
+#endif /* ULOG_ENABLE_ASYNC_MODE */
+
+    if ( message && length )
+    {
+      const RecordInfo info = { RecordType::TEXT, Level::LVL_FATAL, DefaultModule,
+                                recordSequence.fetch_add( 1, std::memory_order_relaxed ), readTick() };
+
+      for ( size_t i = 0; i < snapshot->count; i++ )
+      {
+        panicDeliver( snapshot->sinks[ i ], info, message, length );
+      }
+    }
+  }
+
+  static void panicDeliver( SinkInterface *const sink, const RecordInfo &info, const void *const message, const size_t length )
+  {
+    if ( ( info.level < sink->getLogLevel() ) || !formatAccepts( sink, info ) )
+    {
+      return;
+    }
+
+    const void *payload  = message;
+    size_t payloadLength = length;
+    std::array<uint8_t, RecordMaxLength> record;
+
+    if ( sink->getRecordFormat() == RecordFormat::BINARY )
+    {
+      payloadLength = encodeRecord( info, message, length, record.data(), record.size() );
+      payload       = record.data();
+    }
+
+    sink->panicLog( info.level, info.tick, payload, payloadLength );
+  }
+
+  void deliveryWorkerThread( void *arg )
+  {
+#if ( ULOG_ENABLE_DELIVERY_WORKERS == 1 )
+    SinkInterface *const only = static_cast<SinkInterface *>( arg );
+
+    DeliveryQueue *attached = nullptr;
+
+    /*------------------------------------------------
+    A pool worker serves every queue not claimed by a
+    dedicated worker. Busy queues are skipped, so pool
+    workers spread out over the sinks on their own.
+
+    A dedicated worker attaches to its sink's queue once
+    the sink is registered, and moves off it again if the
+    sink is removed, so producers know whether anyone is
+    draining it.
+    ------------------------------------------------*/
+    auto serviceQueues = [ only, &attached ]() {
+      size_t count = 0;
+
+      if ( attached && ( attached->sink.load( std::memory_order_acquire ) != only ) )
+      {
+        attached->workers.fetch_sub( 1, std::memory_order_acq_rel );
+        attached = nullptr;
+      }
+
+      for ( DeliveryQueue &queue : deliveryQueues )
+      {
+        SinkInterface *const sink = queue.sink.load( std::memory_order_acquire );
+
+        if ( sink && ( only ? ( sink == only ) : !queue.dedicated.load( std::memory_order_relaxed ) ) )
+        {
+          if ( only && !attached )
+          {
+            attached = &queue;
+            attached->workers.fetch_add( 1, std::memory_order_acq_rel );
+          }
+
+          count += serviceDeliveryQueue( queue );
+        }
+      }
+
+      return count;
+    };
+
+    markDeliveryThread();
+    deliveryWorkersActive.fetch_add( 1, std::memory_order_acq_rel );
+    if ( !only )
+    {
+      deliveryPoolWorkers.fetch_add( 1, std::memory_order_acq_rel );
+    }
+
+    while ( !deliveryWorkersStop.load( std::memory_order_acquire ) )
+    {
+      if ( !serviceQueues() )
+      {
+        Chimera::delayMilliseconds( ULOG_DELIVERY_WORKER_IDLE_MS );
+      }
+    }
+
+    while ( serviceQueues() )
+    {
+    }
+
+    if ( attached )
+    {
+      attached->workers.fetch_sub( 1, std::memory_order_acq_rel );
+    }
+    else if ( !only )
+    {
+      deliveryPoolWorkers.fetch_sub( 1, std::memory_order_acq_rel );
+    }
+
+    deliveryWorkersActive.fetch_sub( 1, std::memory_order_acq_rel );
+#else
+    ( void )arg;
+#endif /* ULOG_ENABLE_DELIVERY_WORKERS */
+  }
+
+  void stopDeliveryWorkers()
+  {
+#if ( ULOG_ENABLE_DELIVERY_WORKERS == 1 )
+    deliveryWorkersStop.store( true, std::memory_order_release );
+
+    while ( deliveryWorkersActive.load( std::memory_order_acquire ) )
+    {
+      Chimera::delayMilliseconds( ULOG_DELIVERY_WORKER_IDLE_MS );
+    }
+
+    deliveryWorkersStop.store( false, std::memory_order_release );
+#endif /* ULOG_ENABLE_DELIVERY_WORKERS */
+  }
+
+  size_t getDeliveryBacklog( const SinkHandle &sink )
+  {
+#if ( ULOG_ENABLE_DELIVERY_WORKERS == 1 )
+    SinkInterface *const target = sinkPointer( sink );
+
+    for ( const DeliveryQueue &queue : deliveryQueues )
+    {
+      if ( target && ( queue.sink.load( std::memory_order_acquire ) == target ) )
+      {
+        const size_t delivered = queue.delivered.load( std::memory_order_acquire );
+        const size_t queued    = queue.queued.load( std::memory_order_acquire );
+
+        return ( queued > delivered ) ? ( queued - delivered ) : 0;
+      }
+    }
+#else
+    ( void )sink;
+#endif /* ULOG_ENABLE_DELIVERY_WORKERS */
+
+    return 0;
+  }
+
+  void asyncDrainThread( void *arg )
+  {
+    ( void )arg;
 
+#if ( ULOG_ENABLE_ASYNC_MODE == 1 )
+    markDeliveryThread();
+    asyncDrainActive.store( true, std::memory_order_release );
 
-namespace uLog
-{
-  static bool uLogInitialized      = false;
-  static Level globalLogLevel      = Level::LVL_MIN;
-  static SinkHandle globalRootSink = nullptr;
-  static std::array<SinkHandle, ULOG_MAX_REGISTERABLE_SINKS> sinkRegistry;
+    while ( !asyncDrainStop.load( std::memory_order_acquire ) )
+    {
+      serviceMetricsDump();
 
-  static size_t defaultLockTimeout = 100;
-  static Chimera::Thread::RecursiveTimedMutex threadLock;
+      if ( !drainAsyncQueue() )
+      {
+#if ( ULOG_ENABLE_COALESCING == 1 )
+        sweepRepeatSummaries( true );
+#endif
+        Chimera::delayMilliseconds( ULOG_ASYNC_DRAIN_IDLE_MS );
+      }
+    }
 
-  /**
-   *  Looks up the registry index associated with a particular sink handle
-   *
-   *  @param[in]  sinkHandle  The handle to search for
-   *  @return size_t
-   */
-  static size_t getSinkOffsetIndex( const SinkHandle &sinkHandle );
+    /*------------------------------------------------
+    Don't leave anything behind on the way out
+    ------------------------------------------------*/
+    drainAsyncQueue();
+    asyncDrainStop.store( false, std::memory_order_release );
+    asyncDrainActive.store( false, std::memory_order_release );
+#endif /* ULOG_ENABLE_ASYNC_MODE */
+  }
 
-  void initialize()
+  void stopAsyncDrain()
   {
-    Chimera::Thread::LockGuard x( threadLock );
+#if ( ULOG_ENABLE_ASYNC_MODE == 1 )
+    asyncDrainStop.store( true, std::memory_order_release );
+#endif /* ULOG_ENABLE_ASYNC_MODE */
+  }
 
-    if ( !uLogInitialized )
+#if ( ULOG_ENABLE_ASYNC_MODE == 1 )
+#if ( ULOG_ASYNC_PER_THREAD_QUEUES == 1 )
+  size_t drainAsyncQueue()
+  {
+    /*------------------------------------------------
+    The per thread rings allow one consumer. If another
+    thread is draining, the work is already being done.
+    ------------------------------------------------*/
+    if ( asyncConsumerBusy.test_and_set( std::memory_order_acquire ) )
     {
-      sinkRegistry.fill( nullptr );
-      uLogInitialized = true;
+      return 0;
     }
+
+    /*------------------------------------------------
+    Empty entries are cancelled reservations
+    ------------------------------------------------*/
+    const size_t count = mergeAsyncQueues( false, []( AsyncMessage &entry ) {
+      if ( entry.length )
+      {
+        dispatch( entry.info, entry.data.data(), entry.length );
+      }
+    } );
+
+    asyncConsumerBusy.clear( std::memory_order_release );
+    return count;
   }
 
-  Result setGlobalLogLevel( const Level level )
+  static uint32_t queuedSequence()
   {
-    Chimera::Thread::LockGuard x( threadLock );
+    /*------------------------------------------------
+    Numbered by mergeAsyncQueues() in delivery order, so
+    producers never touch the shared counter
+    ------------------------------------------------*/
+    return 0;
+  }
 
-    globalLogLevel = level;
-    return Result::RESULT_SUCCESS;
+  static size_t asyncQueuedTotal()
+  {
+    size_t total = asyncQueuedCount.load( std::memory_order_acquire );
+
+    for ( const ProducerQueue &queue : producerQueues )
+    {
+      total += queue.queued.load( std::memory_order_acquire );
+    }
+
+    return total;
   }
 
-  Result registerSink( SinkHandle &sink, const uLog::Config options )
+  static ProducerQueue *producerQueue()
   {
-    constexpr size_t invalidIndex = std::numeric_limits<size_t>::max();
+    if ( producerLease.queue )
+    {
+      return producerLease.queue;
+    }
 
-    Chimera::Thread::TimedLockGuard x( threadLock );
-    size_t nullIndex      = invalidIndex;           /* First index that doesn't have a sink registered */
-    bool sinkIsRegistered = false;                  /* Indicates if the sink we are registering already exists */
-    bool registryIsFull   = true;                   /* Is the registry full of sinks? */
-    auto result           = Result::RESULT_SUCCESS; /* Function return code */
+    for ( ProducerQueue &queue : producerQueues )
+    {
+      if ( !queue.owned.load( std::memory_order_relaxed ) && !queue.owned.exchange( true, std::memory_order_acquire ) )
+      {
+        producerLease.queue = &queue;
+        return &queue;
+      }
+    }
+
+    return nullptr;
+  }
 
-    if ( x.try_lock_for( defaultLockTimeout ) )
+  static Tick beginProducerWrite( ProducerQueue *const queue )
+  {
+    /*------------------------------------------------
+    Announce a lower bound on the record's tick before
+    reading the clock, so the drain can't let a newer
+    record from another thread go out ahead of it
+    ------------------------------------------------*/
+    if ( !queue->writers++ )
     {
-      /*------------------------------------------------
-      Check if the sink already is registered as well as
-      an empty slot to insert the new sink.
-      ------------------------------------------------*/
-      for ( size_t i = 0; i < sinkRegistry.size(); i++ )
+      queue->pending.store( queue->lastTick, std::memory_order_seq_cst );
+    }
+
+    const Tick tick = readTick();
+    queue->lastTick = tick;
+    return tick;
+  }
+
+  static void endProducerWrite( ProducerQueue *const queue )
+  {
+    if ( !--queue->writers )
+    {
+      queue->pending.store( IdleTick, std::memory_order_release );
+    }
+  }
+
+  template<typename Deliver>
+  static size_t mergeAsyncQueues( const bool everything, Deliver &&deliver )
+  {
+    /*------------------------------------------------
+    Records up to the horizon are safe to deliver. A
+    producer partway through a record has left a tick
+    no newer than it in 'pending', and a record started
+    after these loads is stamped no earlier than 'now'.
+    The clock must be read before the loads.
+    ------------------------------------------------*/
+    Tick horizon = everything ? IdleTick : readTick();
+
+    for ( const ProducerQueue &queue : producerQueues )
+    {
+      if ( !everything )
       {
-        /* Did we find the first location that is free? */
-        if ( ( nullIndex == invalidIndex ) && ( sinkRegistry[ i ] == nullptr ) )
-        {
-          nullIndex = i;
-          registryIsFull = false;
-        }
+        horizon = std::min( horizon, queue.pending.load( std::memory_order_seq_cst ) );
+      }
+    }
 
-        /* Does the sink already exist in the registry? */
-        if ( sinkRegistry[ i ] == sink )
-        {
-          sinkIsRegistered = true;
-          registryIsFull = false;
-          result = Result::RESULT_SUCCESS;
-          break;
-        }
+    /*------------------------------------------------
+    Repeatedly take the oldest head. The shared queue
+    can't be peeked, so its head waits in asyncStaged.
+    ------------------------------------------------*/
+    size_t count = 0;
+
+    while ( true )
+    {
+      if ( !asyncStagedValid )
+      {
+        asyncStagedValid = asyncQueue.pop( []( AsyncMessage &entry ) { asyncStaged = entry; } );
       }
 
-      /*------------------------------------------------
-      Perform the registration
-      ------------------------------------------------*/
-      if ( !sinkIsRegistered )
+      AsyncMessage *oldest  = asyncStagedValid ? &asyncStaged : nullptr;
+      ProducerQueue *source  = nullptr;
+
+      for ( ProducerQueue &queue : producerQueues )
       {
-        if ( registryIsFull )
-        {
-          result = Result::RESULT_FULL;
-        }
-        else if ( sink->open() != Result::RESULT_SUCCESS )
-        {
-          result = Result::RESULT_FAIL;
-        }
-        else
+        AsyncMessage *const head = queue.ring.front();
+
+        if ( head && ( !oldest || ( head->info.tick < oldest->info.tick ) ) )
         {
-          sinkRegistry[ nullIndex ] = sink;
+          oldest = head;
+          source = &queue;
         }
       }
+
+      if ( !oldest || ( oldest->info.tick > horizon ) )
+      {
+        break;
+      }
+
+      if ( oldest->length )
+      {
+        oldest->info.sequence = recordSequence.fetch_add( 1, std::memory_order_relaxed );
+      }
+
+      deliver( *oldest );
+
+      if ( source )
+      {
+        source->ring.pop();
+      }
+      else
+      {
+        asyncStagedValid = false;
+      }
+
+      asyncDeliveredCount.fetch_add( 1, std::memory_order_release );
+      count++;
     }
 
-    return result;
+    return count;
   }
+#else
+  size_t drainAsyncQueue()
+  {
+    size_t count = 0;
 
-  Result removeSink( SinkHandle &sink )
+    /*------------------------------------------------
+    Empty entries are cancelled reservations
+    ------------------------------------------------*/
+    auto deliverEntry = []( AsyncMessage &entry ) {
+      if ( entry.length )
+      {
+        dispatch( entry.info, entry.data.data(), entry.length );
+      }
+    };
+
+    while ( asyncQueue.pop( deliverEntry ) )
+    {
+      asyncDeliveredCount.fetch_add( 1, std::memory_order_release );
+      count++;
+    }
+
+    return count;
+  }
+
+  static uint32_t queuedSequence()
   {
-    Result result = Result::RESULT_LOCKED;
-    Chimera::Thread::TimedLockGuard x( threadLock );
+    return recordSequence.fetch_add( 1, std::memory_order_relaxed );
+  }
+
+  static size_t asyncQueuedTotal()
+  {
+    return asyncQueuedCount.load( std::memory_order_acquire );
+  }
+#endif /* ULOG_ASYNC_PER_THREAD_QUEUES */
+
+  static bool claimQueueEntry( const Level level, Tick &tick, QueueClaim &claim )
+  {
+    /*------------------------------------------------
+    A full queue drops the message, except for FATAL,
+    which waits for room. With no drain thread running,
+    make the room here.
+    ------------------------------------------------*/
+    auto waitForRoom = []() {
+      if ( !asyncDrainActive.load( std::memory_order_acquire ) )
+      {
+        drainAsyncQueue();
+      }
+      else
+      {
+        Chimera::delayMilliseconds( ULOG_ASYNC_DRAIN_IDLE_MS );
+      }
+    };
+
+#if ( ULOG_ASYNC_PER_THREAD_QUEUES == 1 )
+    claim.queue = producerQueue();
 
-    if ( x.try_lock_for( defaultLockTimeout ) )
+    if ( claim.queue )
     {
-      auto index = getSinkOffsetIndex( sink );
-      if ( index < sinkRegistry.size() )
+      tick        = beginProducerWrite( claim.queue );
+      claim.entry = claim.queue->ring.claim( claim.ticket );
+
+      while ( !claim.entry && ( level == Level::LVL_FATAL ) )
       {
-        result = sinkRegistry[ index ]->close();
+        waitForRoom();
+        claim.entry = claim.queue->ring.claim( claim.ticket );
+      }
 
-        sinkRegistry[ index ].reset();
-        sinkRegistry[ index ] = nullptr;
-        result = Result::RESULT_SUCCESS;
+      if ( !claim.entry )
+      {
+        endProducerWrite( claim.queue );
+        asyncDroppedCount.fetch_add( 1, std::memory_order_relaxed );
+        return false;
       }
-      else if ( sink == nullptr )
+
+      return true;
+    }
+#endif /* ULOG_ASYNC_PER_THREAD_QUEUES */
+
+    tick        = readTick();
+    claim.entry = asyncQueue.claim( claim.ticket );
+
+    while ( !claim.entry && ( level == Level::LVL_FATAL ) )
+    {
+      waitForRoom();
+      claim.entry = asyncQueue.claim( claim.ticket );
+    }
+
+    if ( !claim.entry )
+    {
+      asyncDroppedCount.fetch_add( 1, std::memory_order_relaxed );
+      return false;
+    }
+
+    return true;
+  }
+
+  static void publishQueueEntry( const QueueClaim &claim )
+  {
+#if ( ULOG_ASYNC_PER_THREAD_QUEUES == 1 )
+    if ( ProducerQueue *const queue = claim.queue; queue )
+    {
+      /*------------------------------------------------
+      Only this thread writes 'queued', so no atomic add
+      ------------------------------------------------*/
+      queue->ring.publish( claim.ticket );
+      queue->queued.store( queue->queued.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+      endProducerWrite( queue );
+      return;
+    }
+#endif /* ULOG_ASYNC_PER_THREAD_QUEUES */
+
+    asyncQueue.publish( claim.ticket );
+    asyncQueuedCount.fetch_add( 1, std::memory_order_release );
+  }
+#endif /* ULOG_ENABLE_ASYNC_MODE */
+
+#if ( ULOG_ENABLE_DELIVERY_WORKERS == 1 )
+  static Result enqueueDelivery( DeliveryQueue *const queue, SinkInterface *const sink, const RecordInfo &info,
+                                 const void *const message, const size_t length )
+  {
+    const Level level = info.level;
+
+    if ( length > ULOG_MAX_SNPRINTF_BUFFER_LENGTH )
+    {
+      sink->countDrops( level, 1 );
+      return Result::RESULT_FULL;
+    }
+
+    auto fill = [ & ]( AsyncMessage &entry ) {
+      entry.info   = info;
+      entry.length = length;
+      memcpy( entry.data.data(), message, length );
+    };
+
+    /*------------------------------------------------
+    A full queue is the sink being slow, so its policy
+    decides how long to wait. FATAL always waits. With
+    no worker serving this queue, make the room here.
+    ------------------------------------------------*/
+    const BackpressurePolicy policy = sink->getBackpressure( level );
+    size_t waited                   = 0;
+
+    while ( !queue->ring.push( fill ) )
+    {
+      const bool patient = ( level == Level::LVL_FATAL ) || ( policy.waitMs == WaitForever ) || ( waited < policy.waitMs );
+
+      if ( patient )
       {
-        for ( size_t i = 0; i < sinkRegistry.size(); i++ )
+        if ( deliveryQueueServed( *queue ) || !serviceDeliveryQueue( *queue ) )
         {
-          if ( sinkRegistry[ i ] )
+          Chimera::delayMilliseconds( ULOG_DELIVERY_WORKER_IDLE_MS );
+          waited += ULOG_DELIVERY_WORKER_IDLE_MS;
+        }
+      }
+      else if ( policy.action == Backpressure::DROP_OLDEST )
+      {
+        /*----------------------------------------------
+        A worker may have emptied the queue in between,
+        so only count an entry that was really taken
+        ----------------------------------------------*/
+        const bool dropped = queue->ring.pop( [ sink ]( AsyncMessage &entry ) {
+          if ( entry.length )
           {
-            sinkRegistry[ i ]->close();
-            sinkRegistry[ i ].reset();
-            sinkRegistry[ i ] = nullptr;
+            sink->countDrops( entry.info.level, 1 );
           }
-        }
+        } );
 
-        result = Result::RESULT_SUCCESS;
+        if ( dropped )
+        {
+          queue->delivered.fetch_add( 1, std::memory_order_release );
+        }
+      }
+      else if ( ( policy.action == Backpressure::SPILL ) && spillRecord( sink, policy, info, message, length ) )
+      {
+        sink->countSpill();
+        return Result::RESULT_SUCCESS;
+      }
+      else
+      {
+        sink->countDrops( level, 1 );
+        return Result::RESULT_FULL;
       }
     }
 
-    return result;
+    queue->queued.fetch_add( 1, std::memory_order_release );
+    return Result::RESULT_SUCCESS;
   }
 
-  Result setRootSink( SinkHandle &sink )
+  static size_t serviceDeliveryQueue( DeliveryQueue &queue )
   {
-    Result result = Result::RESULT_LOCKED;
-    Chimera::Thread::TimedLockGuard x( threadLock );
-
-    if ( x.try_lock_for( defaultLockTimeout ) )
+    if ( queue.busy.test_and_set( std::memory_order_acquire ) )
     {
-      globalRootSink = sink;
-      result = Result::RESULT_SUCCESS;
+      return 0;
     }
 
-    return result;
+    const size_t count = deliverQueued( queue, queue.ring.capacity() );
+
+    queue.busy.clear( std::memory_order_release );
+    return count;
   }
 
-  SinkHandle getRootSink()
+  static bool deliveryQueueServed( const DeliveryQueue &queue )
   {
-    return globalRootSink;
+    if ( queue.dedicated.load( std::memory_order_relaxed ) )
+    {
+      return queue.workers.load( std::memory_order_acquire ) != 0;
+    }
+
+    return deliveryPoolWorkers.load( std::memory_order_acquire ) != 0;
   }
 
-  size_t getSinkOffsetIndex( const SinkHandle &sinkHandle )
+  static size_t deliverQueued( DeliveryQueue &queue, const size_t limit )
   {
-    /*------------------------------------------------
-    Figure out the real addresses and boundary limit them
+    SinkInterface *const sink = queue.sink.load( std::memory_order_acquire );
+    size_t count              = 0;
 
-    Note: I'm going to run into trouble if packing is weird...
-    ------------------------------------------------*/
-    std::uintptr_t offsetAddress = reinterpret_cast<std::uintptr_t>( &sinkHandle );
-    std::uintptr_t beginAddress  = reinterpret_cast<std::uintptr_t>( &sinkRegistry[ 0 ] );
-    std::uintptr_t secondAddress = reinterpret_cast<std::uintptr_t>( &sinkRegistry[ 1 ] );
-    size_t elementSize = secondAddress - beginAddress;
+    auto deliverEntry = [ sink ]( AsyncMessage &entry ) {
+      if ( !entry.length )
+      {
+        return;
+      }
+
+#if ( ULOG_ENABLE_COALESCING == 1 )
+      deliverToSink( sink, entry.info, entry.data.data(), entry.length, Coalescer::hash( entry.data.data(), entry.length ),
+                     Chimera::millis() );
+#else
+      deliverToSink( sink, entry.info, entry.data.data(), entry.length, 0, 0 );
+#endif
+    };
 
-    if ( ( sinkHandle == nullptr ) || ( beginAddress > offsetAddress ) || !elementSize )
+    while ( sink && ( count < limit ) && queue.ring.pop( deliverEntry ) )
     {
-      return std::numeric_limits<size_t>::max();
+      queue.delivered.fetch_add( 1, std::memory_order_release );
+      count++;
     }
 
-    /*------------------------------------------------
-    Calculate the index
-    ------------------------------------------------*/
-    size_t index = ( offsetAddress - beginAddress ) / elementSize;
+    return count;
+  }
 
-    if ( index > sinkRegistry.size() )
+  static DeliveryQueue *freeDeliveryQueue()
+  {
+    for ( DeliveryQueue &queue : deliveryQueues )
     {
-      index = std::numeric_limits<size_t>::max();
+      if ( !queue.sink.load( std::memory_order_acquire ) )
+      {
+        return &queue;
+      }
     }
 
-    return index;
+    return nullptr;
   }
 
-  Result log( const Level level, const void *const message, const size_t length )
+  static void retireDeliveryQueue( DeliveryQueue &queue )
   {
     /*------------------------------------------------
-    Input boundary checking
+    Wait out a worker that is mid-delivery, then finish
+    the queue here so the sink gets everything it was
+    sent before it is closed
     ------------------------------------------------*/
-    Chimera::Thread::TimedLockGuard x( threadLock );
-    if ( !x.try_lock_for( defaultLockTimeout ) )
-    {
-      return Result::RESULT_LOCKED;
-    }
-    else if ( ( level < globalLogLevel ) || !message || !length )
+    while ( queue.busy.test_and_set( std::memory_order_acquire ) )
     {
-      return Result::RESULT_FAIL;
+      Chimera::delayMilliseconds( ULOG_DELIVERY_WORKER_IDLE_MS );
     }
 
-    /*------------------------------------------------
-    Process the message through each sink. At the moment
-    we won't concern ourselves if a sink failed to log.
-    ------------------------------------------------*/
-    for ( size_t i = 0; i < sinkRegistry.size(); i++ )
+    while ( deliverQueued( queue, queue.ring.capacity() ) )
     {
-      if ( sinkRegistry[ i ] && ( sinkRegistry[ i ]->getLogLevel() >= globalLogLevel ) )
-      {
-        sinkRegistry[ i ]->log( level, message, length );
-      }
     }
 
-    return Result::RESULT_SUCCESS;
+    queue.sink.store( nullptr, std::memory_order_release );
+    queue.dedicated.store( false, std::memory_order_relaxed );
+    queue.busy.clear( std::memory_order_release );
   }
+#endif /* ULOG_ENABLE_DELIVERY_WORKERS */
 
-}    // namespace uLog
\ No newline at end of file
+}    // namespace uLog
@@ -13,15 +13,25 @@
 #define MICRO_LOGGER_HPP
 
 /* C++ Includes */
+#include <algorithm>
 #include <array>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <string>
 
 /* uLog Includes */
 #include <uLog/config.hpp>
+#include <uLog/crash_handler.hpp>
+#include <uLog/format.hpp>
+#include <uLog/macros.hpp>
+#include <uLog/metrics.hpp>
+#include <uLog/record.hpp>
+#include <uLog/reservation.hpp>
+#include <uLog/scratch.hpp>
 #include <uLog/types.hpp>
 #include <uLog/sinks/sink_intf.hpp>
+#include <uLog/sinks/sink_storage.hpp>
 
 namespace uLog
 {
@@ -42,10 +52,49 @@ namespace uLog
   Result setGlobalLogLevel( const Level level );
 
   /**
-   *  Registers a sink with the back end driver
+   *  Gives one module its own minimum level, independent of the global level.
+   *  Takes effect immediately for every thread; safe to call at runtime to
+   *  turn up the verbosity of a single subsystem. Sinks still apply their own
+   *  levels on top of this.
+   *
+   *  @param[in]  module    The module to adjust
+   *  @param[in]  level     The minimum level for that module
+   *  @return Result        RESULT_FAIL if the module ID is out of range
+   */
+  Result setModuleLevel( const ModuleId module, const Level level );
+
+  /**
+   *  Returns a module to following the global log level
+   *
+   *  @param[in]  module    The module to reset
+   *  @return Result        RESULT_FAIL if the module ID is out of range
+   */
+  Result clearModuleLevel( const ModuleId module );
+
+  /**
+   *  Rebuilds the cached dispatch filter after a registered sink's log level
+   *  changed. Called automatically by SinkInterface::setLogLevel(). Takes no
+   *  lock, so a sink may change its level from inside its own log().
+   *
+   *  @return void
+   */
+  void refreshSinkLevels();
+
+  /**
+   *  Registers a sink with the back end driver. With CFG_DELIVERY_QUEUED or
+   *  CFG_DELIVERY_DEDICATED in the options, the sink is fed from a queue of
+   *  its own by a delivery worker (see deliveryWorkerThread()) instead of by
+   *  the logging thread. A full queue applies the sink's backpressure policy;
+   *  give the sink a dropping policy so it can never hold up the caller.
+   *
+   *  @note Returns RESULT_LOCKED when called from inside a sink's log() or
+   *        with a Reservation open on the calling thread, as the change would
+   *        have to wait on that thread. Needs ULOG_HAS_THREAD_LOCAL to detect.
    *
    *  @param[in]  sink      The sink to be registered
-   *  @return SinkHandleType
+   *  @param[in]  options   Config flags
+   *  @return Result        RESULT_FULL if no delivery queue is free, RESULT_FAIL
+   *                        if ULOG_ENABLE_DELIVERY_WORKERS is off but asked for
    */
   Result registerSink( SinkHandle &sink, const uLog::Config options = CFG_NONE );
 
@@ -53,6 +102,7 @@ namespace uLog
    *  Removes the associated sink.
    *
    *  @note If nullptr is passed in, all sinks are removed.
+   *  @note Returns RESULT_LOCKED from inside a sink, like registerSink().
    *
    *  @param[in]  sink      The sink that should be removed
    *  @return ResultType
@@ -68,7 +118,9 @@ namespace uLog
   Result setRootSink( SinkHandle &sink );
 
   /**
-   *  Gets the default global logger instance
+   *  Gets the default global logger instance. The returned handle keeps the
+   *  sink alive even if setRootSink() replaces it; with static sink storage
+   *  it is a plain pointer and the application owns the sink's lifetime.
    *
    *  @return SinkHandle
    */
@@ -85,6 +137,233 @@ namespace uLog
    */
   Result log( const Level lvl, const void *const msg, const size_t length );
 
+  /**
+   *  Same as log(), but filtered by and tagged with a module
+   *
+   *  @param[in]  module    The module the message came from
+   *  @param[in]  lvl       The severity level of the message to be logged
+   *  @param[in]  msg       Raw byte message to be logged
+   *  @param[in]  length    Length of the log message
+   *  @return Result
+   */
+  Result log( const ModuleId module, const Level lvl, const void *const msg, const size_t length );
+
+  /**
+   *  Same as log(), but tags the message with a payload type other than text.
+   *  Sinks in RecordFormat::BINARY carry the type in the record header.
+   *
+   *  @param[in]  type      How the payload should be interpreted
+   *  @param[in]  module    The module the message came from
+   *  @param[in]  lvl       The severity level of the message to be logged
+   *  @param[in]  msg       Raw byte message to be logged
+   *  @param[in]  length    Length of the log message
+   *  @return Result
+   */
+  Result logRecord( const RecordType type, const ModuleId module, const Level lvl, const void *const msg, const size_t length );
+
+  /**
+   *  Checks if a message at the given level would reach at least one sink. This
+   *  is a single atomic load and is meant to be called before doing any work to
+   *  build the message.
+   *
+   *  @param[in]  lvl       The severity level to check
+   *  @return bool
+   */
+  bool isLevelEnabled( const Level lvl );
+
+  /**
+   *  Checks if a message from a module at the given level would reach at least
+   *  one sink. A single indexed load of the module's filter mask.
+   *
+   *  @param[in]  module    The module the message would come from
+   *  @param[in]  lvl       The severity level to check
+   *  @return bool
+   */
+  bool isLevelEnabled( const ModuleId module, const Level lvl );
+
+  /**
+   *  Formats a message once and hands the same bytes to every registered sink
+   *  that accepts the level. Nothing is formatted if the module's filter or
+   *  the sinks would reject it.
+   *
+   *  @param[in]  module    The module the message came from
+   *  @param[in]  lvl       The severity level of the message to be logged
+   *  @param[in]  str       ULOG_FMT() format string, or a printf style one
+   *  @param[in]  args      Arguments referenced by the format string
+   *  @return Result        RESULT_FAIL if the level is filtered out
+   */
+  template<typename Fmt, typename... Args>
+  Result flog( const ModuleId module, const Level lvl, const Fmt &str, Args const &... args )
+  {
+    if ( !isLevelEnabled( module, lvl ) )
+    {
+      return Result::RESULT_FAIL;
+    }
+
+    ScratchBuffer scratch;
+    if ( !scratch.valid() )
+    {
+      return Result::RESULT_FULL;
+    }
+
+    const size_t length = Format::format( scratch.data(), scratch.size(), str, args... );
+    return log( module, lvl, scratch.data(), length );
+  }
+
+  /**
+   *  Same as the module aware flog(), logging on behalf of DefaultModule
+   *
+   *  @param[in]  lvl       The severity level of the message to be logged
+   *  @param[in]  str       ULOG_FMT() format string, or a printf style one
+   *  @param[in]  args      Arguments referenced by the format string
+   *  @return Result        RESULT_FAIL if the level is filtered out
+   */
+  template<typename Fmt, typename... Args>
+  Result flog( const Level lvl, const Fmt &str, Args const &... args )
+  {
+    return flog( DefaultModule, lvl, str, args... );
+  }
+
+  /**
+   *  Number of messages turned away because the asynchronous queue was full.
+   *  Always zero unless ULOG_ENABLE_ASYNC_MODE is set. Messages lost inside a
+   *  sink are counted by SinkInterface::getDropCount().
+   *
+   *  @return size_t
+   */
+  size_t getQueueDropCount();
+
+  /**
+   *  Copies out the process wide self-metrics. All zero unless
+   *  ULOG_ENABLE_METRICS is set. Per sink figures come from
+   *  SinkInterface::getLatency() and SinkInterface::getDropCount().
+   *
+   *  @param[out] metrics   Receives the counters
+   *  @return void
+   */
+  void getMetrics( Metrics &metrics );
+
+  /**
+   *  Zeroes the process wide counters and the latency histograms of the
+   *  registered sinks
+   *
+   *  @return void
+   */
+  void resetMetrics();
+
+  /**
+   *  Writes a readable metrics report to a sink: one line of process wide
+   *  counters, then one line per registered sink with its latency percentiles
+   *  and drop counts. Lines are logged at LVL_INFO.
+   *
+   *  @param[in]  sink      Where the report goes
+   *  @return Result
+   */
+  Result dumpMetrics( SinkHandle &sink );
+
+  /**
+   *  Has the report from dumpMetrics() written to a sink every so often. The
+   *  check rides along with log() calls, or the drain thread in async mode,
+   *  so the report only goes out while something is logging.
+   *
+   *  @param[in]  sink        Where the report goes, nullptr to stop
+   *  @param[in]  intervalMs  Time between reports, zero to stop
+   *  @return Result
+   */
+  Result setMetricsDump( SinkHandle &sink, const size_t intervalMs );
+
+  /**
+   *  Blocks until every message logged before this call has been handed to the
+   *  registered sinks, then flushes each sink. Called automatically after every
+   *  LVL_FATAL message when ULOG_FLUSH_ON_FATAL is set.
+   *
+   *  @note In asynchronous mode without a running drain thread, the pending
+   *        messages are delivered on the calling thread instead.
+   *  @note Waits on the drain thread and the delivery workers and takes every
+   *        sink lock, so it must not be called from those threads, from inside
+   *        a sink, while holding an asynchronous Reservation, or while holding
+   *        a lock a sink needs. The automatic FATAL flush is skipped on all but
+   *        the last.
+   *
+   *  @return Result
+   */
+  Result flush();
+
+  /**
+   *  Last ditch delivery for a process that is about to die. Pushes out what
+   *  each sink is holding, then whatever is still in the asynchronous queue,
+   *  then an optional final message at LVL_FATAL, all straight to the sinks'
+   *  devices. Only async-signal-safe operations are used and no lock is taken,
+   *  so it may be called from a signal handler (see installCrashHandler()).
+   *  Sinks without SinkInterface::panicLog() support are skipped. Only the
+   *  first call does anything.
+   *
+   *  @note Another thread may be inside a sink at the same time, so output
+   *        can interleave with, or repeat, a write that was in progress.
+   *  @note With ULOG_ASYNC_PER_THREAD_QUEUES, the queues are skipped if the
+   *        drain was interrupted while merging them, as they only allow one
+   *        consumer.
+   *
+   *  @param[in]  message   Final message, or nullptr
+   *  @param[in]  length    Length of the final message
+   *  @return void
+   */
+  void panicFlush( const void *const message = nullptr, const size_t length = 0 );
+
+  /**
+   *  Entry point for a thread that delivers to the sinks registered with a
+   *  delivery queue. Only does work when ULOG_ENABLE_DELIVERY_WORKERS is set.
+   *  Any number of pool workers may run; each takes one sink's queue at a time,
+   *  so a slow sink ties up a single worker while the rest keep the other
+   *  sinks moving. Runs until stopDeliveryWorkers() is called.
+   *
+   *  @note With no worker serving a queue (no pool worker, or for a
+   *        CFG_DELIVERY_DEDICATED sink no worker of its own), its messages are
+   *        delivered by flush() or by a caller waiting on it while it is full.
+   *
+   *  @param[in]  arg       nullptr to serve every CFG_DELIVERY_QUEUED sink, or
+   *                        the SinkInterface * of a CFG_DELIVERY_DEDICATED sink
+   *                        to serve only that one
+   *  @return void
+   */
+  void deliveryWorkerThread( void *arg );
+
+  /**
+   *  Requests every delivery worker to empty the queues it serves and then
+   *  exit. Blocks until they have.
+   *
+   *  @return void
+   */
+  void stopDeliveryWorkers();
+
+  /**
+   *  Number of messages waiting in a sink's delivery queue. Zero for sinks
+   *  without one. Messages the queue turned away are counted by
+   *  SinkInterface::getDropCount().
+   *
+   *  @param[in]  sink      The sink to check
+   *  @return size_t
+   */
+  size_t getDeliveryBacklog( const SinkHandle &sink );
+
+  /**
+   *  Entry point for the thread that delivers asynchronously queued messages
+   *  to the registered sinks. Only does work when ULOG_ENABLE_ASYNC_MODE is set.
+   *  Runs until stopAsyncDrain() is called.
+   *
+   *  @param[in]  arg       Unused
+   *  @return void
+   */
+  void asyncDrainThread( void *arg );
+
+  /**
+   *  Requests the asynchronous drain thread to deliver any remaining messages
+   *  and then exit.
+   *
+   *  @return void
+   */
+  void stopAsyncDrain();
+
 }
 
 #endif  /* MICRO_LOGGER_HPP */